@@ -5,9 +5,13 @@
 
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <util/atomic.h>
 #define F_CPU 16000000UL
 #include <util/delay.h>
 #include "ADC.h"
+#include "Timer.h"
+#include "Scheduler.h"
+#include "Filter.h"
 
 
 void init_ADC(char ADC_CH, char ADC_REF, char ADC_PRE){
@@ -42,5 +46,376 @@ void ADC_SC(){
 int  ADC_read(){
     // Pooling on Flag
     while(!(ADCSRA & (1<<ADIF)));
+    // Clear the flag (write 1) so the next read waits for a new result
+    ADCSRA |= (1<<ADIF);
     return ADCW;
+}
+
+// --- Interrupt-Driven Free-Running Mode ---
+// Single producer (ADC ISR) / single consumer (main loop) ring buffer.
+// Head is only written by the ISR and tail only by the consumer, and both
+// are 8-bit, so neither side needs to disable interrupts to update them.
+
+static volatile uint16_t ADC_Buffer[ADC_BUFFER_SIZE];
+static volatile uint8_t  ADC_Buffer_Head = 0;
+static volatile uint8_t  ADC_Buffer_Tail = 0;
+static volatile uint16_t ADC_Overruns = 0;
+
+#define ADC_BUFFER_MASK   (ADC_BUFFER_SIZE - 1)
+
+static uint8_t ADC_Trigger = ADC_TRIG_FREE_RUNNING;
+
+#if ADC_TRIGGER_STATS
+static volatile uint32_t ADC_Stats_Last = 0;
+static volatile uint32_t ADC_Stats_Sum = 0;
+static volatile uint16_t ADC_Stats_Count = 0;
+static volatile uint16_t ADC_Stats_Min = 0xFFFF;
+static volatile uint16_t ADC_Stats_Max = 0;
+static volatile uint8_t  ADC_Stats_Started = 0;
+#endif
+
+// --- Scan Sequencer State ---
+// The result table is double buffered: the ISR fills the back half while
+// ADC_Scan_Read copies the front half, they swap after each full sweep.
+
+static uint8_t           ADC_Scan_Channels[ADC_SCAN_MAX_CHANNELS];
+static volatile uint8_t  ADC_Scan_Count = 0;       // 0 = ring buffer mode
+static volatile uint16_t ADC_Scan_Table[2][ADC_SCAN_MAX_CHANNELS];
+static volatile uint8_t  ADC_Scan_Front = 0;
+static volatile uint16_t ADC_Scan_Sweeps = 0;
+static uint8_t ADC_Scan_Result_Idx;   // list entry of the conversion in flight
+static uint8_t ADC_Scan_Mux_Idx;      // list entry currently written to ADMUX
+
+// --- Burst Capture State ---
+// ADC_BURST_IDLE unless a burst runs, the ISR checks it before anything else
+#define ADC_BURST_IDLE      0
+#define ADC_BURST_ARMED     1   // Waiting for the trigger
+#define ADC_BURST_FILLING   2
+
+static volatile uint8_t  ADC_Burst_State = ADC_BURST_IDLE;
+static uint8_t*          ADC_Burst_Buffer;
+static uint8_t           ADC_Burst_Count;
+static uint8_t           ADC_Burst_Index;
+static uint8_t           ADC_Burst_Level;
+static uint8_t           ADC_Burst_Edge;
+static uint8_t           ADC_Burst_Previous;
+static uint16_t          ADC_Burst_Wait;
+static uint32_t          ADC_Burst_Start;
+static volatile uint32_t ADC_Burst_Time = 0;
+static volatile uint8_t  ADC_Burst_Hit = 0;
+
+void ADC_select_TRIGGER(char ADC_TRIG){
+    ADC_Trigger = ADC_TRIG & 0x07;
+}
+
+// Starts the auto-triggered chain with ADC_vect enabled
+static void ADC_Start_Interrupt(void){
+#if ADC_TRIGGER_STATS
+    ADC_Reset_Trigger_Stats();
+#endif
+    // Auto trigger source (ADTS2:0)
+    SFIOR = (SFIOR & ~((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0))) | (ADC_Trigger << ADTS0);
+    ADCSRA |= (1<<ADIF);                          // Drop any stale flag
+    ADCSRA |= (1<<ADATE)|(1<<ADIE);
+    if (ADC_Trigger == ADC_TRIG_FREE_RUNNING) {
+        ADC_SC();                                 // First conversion starts the chain
+    }
+}
+
+// Timer flags with no ISR of their own stay set after triggering, and a
+// conversion only starts on a rising edge: clear them for the next one.
+// Flags whose interrupt is enabled are cleared by that ISR instead.
+static inline void ADC_Rearm_Trigger(void){
+    switch (ADC_Trigger) {
+        case ADC_TRIG_TIMER0_COMP:
+            if (!(TIMSK & (1<<OCIE0))) TIFR = (1<<OCF0);
+            break;
+        case ADC_TRIG_TIMER0_OVF:
+            if (!(TIMSK & (1<<TOIE0))) TIFR = (1<<TOV0);
+            break;
+        case ADC_TRIG_TIMER1_COMP_B:
+            if (!(TIMSK & (1<<OCIE1B))) TIFR = (1<<OCF1B);
+            break;
+        case ADC_TRIG_TIMER1_OVF:
+            if (!(TIMSK & (1<<TOIE1))) TIFR = (1<<TOV1);
+            break;
+        case ADC_TRIG_TIMER1_CAPT:
+            if (!(TIMSK & (1<<TICIE1))) TIFR = (1<<ICF1);
+            break;
+        default:
+            break;
+    }
+}
+
+#if ADC_TRIGGER_STATS
+static inline void ADC_Stats_Update(void){
+    uint32_t now = Timer0_Get_Timestamp();
+
+    if (ADC_Stats_Started) {
+        uint16_t interval = (uint16_t)(now - ADC_Stats_Last);
+        // Saturates instead of wrapping: the rate is then the one over
+        // the first ADC_STATS_MAX_SAMPLES intervals of the window
+        if (ADC_Stats_Count < ADC_STATS_MAX_SAMPLES) {
+            ADC_Stats_Sum += interval;
+            ADC_Stats_Count++;
+        }
+        if (interval < ADC_Stats_Min) ADC_Stats_Min = interval;
+        if (interval > ADC_Stats_Max) ADC_Stats_Max = interval;
+    }
+    ADC_Stats_Last = now;
+    ADC_Stats_Started = 1;
+}
+
+void ADC_Get_Trigger_Stats(ADC_Trigger_Stats* stats){
+    uint32_t sum;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        sum = ADC_Stats_Sum;
+        stats->samples = ADC_Stats_Count;
+        stats->interval_min = ADC_Stats_Min;
+        stats->interval_max = ADC_Stats_Max;
+    }
+    stats->rate_hz = 0;
+    stats->jitter_us = 0;
+    if (sum != 0) {
+        // samples / (sum * 4 us)
+        stats->rate_hz = ((uint32_t)stats->samples * (1000000UL / SCHEDULER_COUNT_US) + sum / 2) / sum;
+        stats->jitter_us = (stats->interval_max - stats->interval_min) * SCHEDULER_COUNT_US;
+    }
+}
+
+void ADC_Reset_Trigger_Stats(void){
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        ADC_Stats_Sum = 0;
+        ADC_Stats_Count = 0;
+        ADC_Stats_Min = 0xFFFF;
+        ADC_Stats_Max = 0;
+        ADC_Stats_Started = 0;
+    }
+}
+#endif
+
+void ADC_Start_FreeRunning(void){
+    ADC_Stop_FreeRunning();
+    ADC_Buffer_Head = 0;
+    ADC_Buffer_Tail = 0;
+    ADC_Overruns = 0;
+    ADC_Scan_Count = 0;
+    Filter_Reset();
+    ADC_Start_Interrupt();
+}
+
+void ADC_Start_Scan(const uint8_t* channels, uint8_t count){
+    uint8_t i;
+
+    ADC_Stop_FreeRunning();
+    if (count > ADC_SCAN_MAX_CHANNELS) {
+        count = ADC_SCAN_MAX_CHANNELS;
+    }
+    for (i = 0; i < count; i++) {
+        ADC_Scan_Channels[i] = channels[i];
+    }
+    ADC_Scan_Count = count;
+    Filter_Reset();
+    ADC_Restart();
+}
+
+void ADC_Restart(void){
+    ADC_Stop_FreeRunning();
+    while (ADCSRA & (1<<ADSC));                   // Let a running conversion finish
+    if (ADC_Scan_Count != 0) {
+        // Free running, the conversion after the first one starts before the
+        // ISR can move the mux, so entry 0 is simply converted twice at the start
+        ADC_Scan_Result_Idx = 0;
+        ADC_Scan_Mux_Idx = 0;
+        ADC_Scan_Front = 0;
+        ADC_Scan_Sweeps = 0;
+        ADC_select_CH(ADC_Scan_Channels[0]);
+    }
+    ADC_Start_Interrupt();
+}
+
+void ADC_Scan_Read(uint16_t* results){
+    uint8_t i;
+
+    // Short copy, keeps the ISR from swapping halves in the middle of it
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        for (i = 0; i < ADC_Scan_Count; i++) {
+            results[i] = ADC_Scan_Table[ADC_Scan_Front][i];
+        }
+    }
+}
+
+uint16_t ADC_Scan_Get_Sweeps(void){
+    uint16_t sweeps;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        sweeps = ADC_Scan_Sweeps;
+    }
+    return sweeps;
+}
+
+void ADC_Start_Burst(uint8_t* buffer, uint8_t count, uint8_t trigger_level,
+                     uint8_t edge, uint16_t timeout){
+    ADC_Stop_FreeRunning();
+    while (ADCSRA & (1<<ADSC));
+
+    ADC_Burst_Buffer = buffer;
+    ADC_Burst_Count = count;
+    ADC_Burst_Index = 0;
+    ADC_Burst_Level = trigger_level;
+    ADC_Burst_Edge = edge;
+    ADC_Burst_Hit = 0;
+    // The first sample only becomes the previous one: start from a value
+    // that cannot cross the level, and give it one extra wait
+    ADC_Burst_Previous = (edge == ADC_BURST_RISING) ? 0xFF : 0x00;
+    ADC_Burst_Wait = (edge == ADC_BURST_NONE) ? 1 : timeout + 1;
+    ADC_Burst_State = ADC_BURST_ARMED;
+
+    SFIOR &= ~((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0));  // Free running
+    ADCSRA |= (1<<ADIF);
+    ADCSRA |= (1<<ADATE)|(1<<ADIE);
+    ADC_SC();
+}
+
+uint8_t ADC_Burst_Done(void){
+    return ADC_Burst_State == ADC_BURST_IDLE;
+}
+
+uint8_t ADC_Burst_Triggered(void){
+    return ADC_Burst_Hit;
+}
+
+uint32_t ADC_Burst_Get_Time(void){
+    uint32_t time;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        time = ADC_Burst_Time;
+    }
+    return time;
+}
+
+void ADC_Stop_FreeRunning(void){
+    ADCSRA &= ~((1<<ADATE)|(1<<ADIE));
+}
+
+uint8_t ADC_Buffer_Count(void){
+    return (uint8_t)(ADC_Buffer_Head - ADC_Buffer_Tail) & ADC_BUFFER_MASK;
+}
+
+// Copies up to max_count oldest samples out of the buffer, returns how many
+uint8_t ADC_Buffer_Read(uint16_t* samples, uint8_t max_count){
+    uint8_t tail = ADC_Buffer_Tail;
+    uint8_t head = ADC_Buffer_Head;
+    uint8_t n = 0;
+
+    while (tail != head && n < max_count) {
+        samples[n++] = ADC_Buffer[tail];
+        tail = (tail + 1) & ADC_BUFFER_MASK;
+    }
+    ADC_Buffer_Tail = tail;
+    return n;
+}
+
+// Number of samples dropped because the buffer was full
+uint16_t ADC_Get_Overruns(void){
+    uint16_t overruns;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        overruns = ADC_Overruns;
+    }
+    return overruns;
+}
+
+// Scan mode: the result belongs to the conversion that was in flight and the
+// mux is moved on to the next entry. Free running, the next conversion is
+// already running on the mux written last time, so the new mux applies to
+// the one after it. Triggered, nothing runs until the next trigger, so the
+// new mux applies to the next conversion.
+static inline void ADC_Scan_ISR(void){
+    uint8_t count = ADC_Scan_Count;
+    uint8_t idx = ADC_Scan_Result_Idx;
+    uint8_t mux = ADC_Scan_Mux_Idx;
+    uint16_t value;
+
+    // Mux first, the filter below does not need to delay it
+    if (ADC_Trigger == ADC_TRIG_FREE_RUNNING) {
+        ADC_Scan_Result_Idx = mux;
+    }
+    if (++mux == count) {
+        mux = 0;
+    }
+    if (ADC_Trigger != ADC_TRIG_FREE_RUNNING) {
+        ADC_Scan_Result_Idx = mux;
+    }
+    ADC_Scan_Mux_Idx = mux;
+    ADMUX = (ADMUX & 0xE0) | ADC_Scan_Channels[mux];
+
+    // Decimating filters only produce an output every few sweeps, and all
+    // entries produce theirs in the same sweep
+    if (!Filter_Push(idx, ADCW, &value)) {
+        return;
+    }
+    ADC_Scan_Table[ADC_Scan_Front ^ 1][idx] = value;
+    if (idx == count - 1) {
+        ADC_Scan_Front ^= 1;       // Sweep complete, publish it
+        ADC_Scan_Sweeps++;
+    }
+}
+
+// Burst: one 8-bit sample per conversion (ADLAR), the trigger search first.
+// The timestamps bracket the count conversions of the fill.
+static inline void ADC_Burst_ISR(void){
+    uint8_t sample = ADCH;
+
+    if (ADC_Burst_State == ADC_BURST_ARMED) {
+        uint8_t previous = ADC_Burst_Previous;
+        uint8_t level = ADC_Burst_Level;
+
+        ADC_Burst_Previous = sample;
+        if ((ADC_Burst_Edge == ADC_BURST_RISING && previous < level && sample >= level)
+            || (ADC_Burst_Edge == ADC_BURST_FALLING && previous > level && sample <= level)) {
+            ADC_Burst_Hit = 1;
+        } else if (--ADC_Burst_Wait != 0) {
+            return;
+        }
+        ADC_Burst_Start = Timer0_Get_Timestamp();
+        ADC_Burst_State = ADC_BURST_FILLING;
+        return;
+    }
+
+    ADC_Burst_Buffer[ADC_Burst_Index] = sample;
+    if (++ADC_Burst_Index == ADC_Burst_Count) {
+        ADC_Burst_Time = (Timer0_Get_Timestamp() - ADC_Burst_Start) & 0x00FFFFFFUL;
+        ADC_Stop_FreeRunning();
+        ADC_Burst_State = ADC_BURST_IDLE;
+    }
+}
+
+ISR(ADC_vect){
+    if (ADC_Burst_State != ADC_BURST_IDLE) {
+        ADC_Burst_ISR();
+        return;
+    }
+    ADC_Rearm_Trigger();
+#if ADC_TRIGGER_STATS
+    ADC_Stats_Update();
+#endif
+
+    if (ADC_Scan_Count != 0) {
+        ADC_Scan_ISR();
+        return;
+    }
+
+    uint16_t value;
+    if (!Filter_Push(0, ADCW, &value)) {
+        return;
+    }
+
+    uint8_t head = ADC_Buffer_Head;
+    uint8_t next = (head + 1) & ADC_BUFFER_MASK;
+
+    if (next == ADC_Buffer_Tail) {
+        ADC_Overruns++;     // Full: keep the older samples, drop this one
+        return;
+    }
+    ADC_Buffer[head] = value;
+    ADC_Buffer_Head = next;
 }
\ No newline at end of file
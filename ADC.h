@@ -9,6 +9,8 @@
 #ifndef ADC_H_INCLUDED
 #define ADC_H_INCLUDED
 
+#include <stdint.h>
+
 #define ADC_REF_AREF      0
 #define ADC_REF_AVCC      1
 #define ADC_REF_2_56V     3
@@ -33,6 +35,26 @@
 #define ADC_PRE_64    6
 #define ADC_PRE_128   7
 
+// Auto trigger sources (SFIOR ADTS2:0). A conversion starts on the rising
+// edge of the source's interrupt flag, so it lands at a fixed point of the
+// timer period with no CPU involvement.
+#define ADC_TRIG_FREE_RUNNING    0
+#define ADC_TRIG_ANALOG_COMP     1
+#define ADC_TRIG_INT0            2
+#define ADC_TRIG_TIMER0_COMP     3
+#define ADC_TRIG_TIMER0_OVF      4
+#define ADC_TRIG_TIMER1_COMP_B   5
+#define ADC_TRIG_TIMER1_OVF      6
+#define ADC_TRIG_TIMER1_CAPT     7
+
+// Set to 0 to drop the sample interval statistics from the ADC ISR
+#ifndef ADC_TRIGGER_STATS
+#define ADC_TRIGGER_STATS        1
+#endif
+
+// Sample ring buffer size for interrupt-driven mode (power of 2)
+#define ADC_BUFFER_SIZE   16
+
 
 void init_ADC(char ADC_CH, char ADC_REF, char ADC_PRE);
 void ADC_select_CH(char ADC_CH);
@@ -42,6 +64,81 @@ void ADC_select_PRE(char ADC_PRE);
 void ADC_SC();
 int  ADC_read();
 
+// --- Interrupt-Driven Free-Running Mode ---
+// Conversions run back to back (or on each ADC_select_TRIGGER event) and the
+// ADC ISR pushes each result, after the Filter.h stage (FILTER_BITS wide),
+// into a ring buffer. Needs global
+// interrupts enabled (sei()).
+// Selects what starts each conversion in the interrupt-driven modes, takes
+// effect on the next ADC_Start_FreeRunning / ADC_Start_Scan / ADC_Restart
+void ADC_select_TRIGGER(char ADC_TRIG);
+void ADC_Start_FreeRunning(void);
+void ADC_Stop_FreeRunning(void);
+uint8_t  ADC_Buffer_Count(void);
+uint8_t  ADC_Buffer_Read(uint16_t* samples, uint8_t max_count);
+uint16_t ADC_Get_Overruns(void);
+
+// --- Scan Sequencer ---
+// Round-robins a channel list in the ADC ISR, auto-triggered (free running
+// or the source picked by ADC_select_TRIGGER). The mux is written one
+// conversion ahead (ADMUX is latched when a conversion starts), so every
+// channel gets a full conversion time to settle. A complete sweep swaps the
+// double-buffered result table. Aggregate rate = ADC clock / 13 when free
+// running, the trigger rate otherwise.
+// The ring buffer above is not fed while scanning.
+#define ADC_SCAN_MAX_CHANNELS   8
+
+void ADC_Start_Scan(const uint8_t* channels, uint8_t count);
+// Copies the latest complete sweep (one result per list entry, in list order)
+void ADC_Scan_Read(uint16_t* results);
+// Completed sweeps, wraps around; a change means ADC_Scan_Read has new data
+uint16_t ADC_Scan_Get_Sweeps(void);
+// Restarts interrupt-driven conversions in the last started mode
+// (ring or scan, auto-triggered: free running or the source picked by
+// ADC_select_TRIGGER), e.g. after borrowing the ADC for polling
+void ADC_Restart(void);
+
+// --- Burst Capture ---
+// Free running 8-bit conversions (the caller sets channel, prescaler and
+// ADLAR first) read by the ADC ISR: it waits for the level to be crossed on
+// the chosen edge, at most timeout samples, then fills count samples into
+// buffer and stops the ADC. The CPU is free meanwhile, poll ADC_Burst_Done.
+// The ring buffer and the scan sequencer are not fed during a burst,
+// ADC_Restart resumes them afterwards.
+#define ADC_BURST_RISING        0
+#define ADC_BURST_FALLING       1
+#define ADC_BURST_NONE          2   // Fill from the first sample on
+
+void     ADC_Start_Burst(uint8_t* buffer, uint8_t count, uint8_t trigger_level,
+                         uint8_t edge, uint16_t timeout);
+// 1 once the buffer is full (and the ADC stopped)
+uint8_t  ADC_Burst_Done(void);
+// 1 if the last burst started on the trigger, 0 if the wait timed out
+uint8_t  ADC_Burst_Triggered(void);
+// Time the last burst took to fill, in Timer0 timestamp counts
+uint32_t ADC_Burst_Get_Time(void);
+
+#if ADC_TRIGGER_STATS
+// --- Sample Timing Statistics ---
+// Intervals between ADC ISRs in Timer0 timestamp counts (4 us at /64). With
+// a hardware trigger the conversion itself starts jitter free; the spread
+// seen here is the upper bound added by interrupt latency.
+// A window counts at most ADC_STATS_MAX_SAMPLES intervals (samples times
+// 250000 still fits 32 bits); ADC_Reset_Trigger_Stats starts a new one.
+#define ADC_STATS_MAX_SAMPLES   16384
+
+typedef struct {
+    uint16_t samples;        // intervals measured (saturates)
+    uint32_t rate_hz;        // achieved conversion rate (all channels)
+    uint16_t interval_min;   // in timestamp counts
+    uint16_t interval_max;
+    uint16_t jitter_us;      // (interval_max - interval_min) in us
+} ADC_Trigger_Stats;
+
+void ADC_Get_Trigger_Stats(ADC_Trigger_Stats* stats);
+void ADC_Reset_Trigger_Stats(void);
+#endif
+
 #endif // ADC_H_INCLUDED
 
 
@@ -0,0 +1,137 @@
+/*
+ * File:   Capture.c
+ * Author: Mostafa Eshra
+ */
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+#include "Capture.h"
+#include "DIO.h"
+
+// Timestamps are (overflows << 10) | ICR1, 16 + 10 bits
+#define CAPTURE_TIMESTAMP_MASK   0x03FFFFFFUL
+
+static volatile uint16_t Capture_Overflows = 0;
+static volatile uint16_t Capture_Idle = 0;      // overflows since the last edge
+
+// Edge state, ISR only
+static uint32_t Capture_Rise = 0;
+static uint32_t Capture_Fall = 0;
+static uint8_t  Capture_Have_Rise = 0;
+
+// Averaging window being summed, ISR only
+static uint32_t Capture_Sum_Period = 0;
+static uint32_t Capture_Sum_High = 0;
+static uint16_t Capture_Sum_Count = 0;
+
+// Sums of the latest complete window, Capture_Period = 0 = no signal
+static volatile uint32_t Capture_Period = 0;
+static volatile uint32_t Capture_High = 0;
+static volatile uint16_t Capture_Count = 0;
+
+void Capture_Init(void){
+    // ICP1 (PD6) input, no pull-up
+    DIO_Set_PIN_DIR(&PORTD, PD6, INPUT);
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        Capture_Period = 0;
+        Capture_Have_Rise = 0;
+        Capture_Sum_Count = 0;
+        Capture_Idle = 0;
+
+        // Noise canceler (4 samples, 250 ns delay), start on a rising edge
+        TCCR1B |= (1 << ICNC1) | (1 << ICES1);
+        TIFR = (1 << ICF1) | (1 << TOV1);
+        TIMSK |= (1 << TICIE1) | (1 << TOIE1);
+    }
+}
+
+void Capture_Get(Capture_Result* result){
+    uint32_t period;
+    uint32_t high;
+    uint16_t count;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        period = Capture_Period;
+        high = Capture_High;
+        count = Capture_Count;
+    }
+
+    result->freq_hz = 0;
+    if (period == 0) {
+        // Stuck at 0% or 100%: report the pin level
+        result->period = 0;
+        result->high = 0;
+        result->duty_permille = (DIO_FAST_PIN_READ(PIND, PD6) == HIGH) ? 1000 : 0;
+        return;
+    }
+
+    // Ratios of the sums, so the fractions of a count are not lost
+    result->period = (period + count / 2) / count;
+    result->high = (high + count / 2) / count;
+    result->freq_hz = (CAPTURE_TIMER1_HZ * count + period / 2) / period;
+    // Keep high * 1000 inside 32 bits
+    while (period > 0x003FFFFFUL) {
+        period >>= 1;
+        high >>= 1;
+    }
+    result->duty_permille = (uint16_t)((high * 1000UL + period / 2) / period);
+}
+
+// --- Timer1 Overflow: Timestamp Extension ---
+// Runs every CAPTURE_TIMER1_STEPS counts (64 us), keep it short
+ISR(TIMER1_OVF_vect){
+    Capture_Overflows++;
+    if (Capture_Idle < CAPTURE_IDLE_OVERFLOWS) {
+        Capture_Idle++;
+    } else {
+        Capture_Period = 0;         // No edges for a while: constant level
+        Capture_Have_Rise = 0;
+        Capture_Sum_Count = 0;
+    }
+}
+
+// --- Input Capture: Edge Timestamps ---
+// Alternates between rising and falling edges. On each rising edge the
+// previous period (rise to rise) and its high time (rise to fall) are added
+// to the window, a full window is published.
+ISR(TIMER1_CAPT_vect){
+    uint16_t icr = ICR1;
+    uint16_t overflows = Capture_Overflows;
+    uint32_t now;
+
+    // The counter wrapped just before the capture and its ISR has not run yet
+    if ((TIFR & (1 << TOV1)) && icr < (CAPTURE_TIMER1_STEPS / 2)) {
+        overflows++;
+    }
+    now = ((uint32_t)overflows << 10) | icr;
+    Capture_Idle = 0;
+
+    if (TCCR1B & (1 << ICES1)) {
+        if (Capture_Have_Rise) {
+            Capture_Sum_Period += (now - Capture_Rise) & CAPTURE_TIMESTAMP_MASK;
+            Capture_Sum_High += (Capture_Fall - Capture_Rise) & CAPTURE_TIMESTAMP_MASK;
+            Capture_Sum_Count++;
+            if (Capture_Sum_Count >= CAPTURE_AVERAGE_PERIODS ||
+                Capture_Sum_Period >= CAPTURE_AVERAGE_COUNTS) {
+                Capture_Period = Capture_Sum_Period;
+                Capture_High = Capture_Sum_High;
+                Capture_Count = Capture_Sum_Count;
+                Capture_Sum_Count = 0;
+            }
+        }
+        if (Capture_Sum_Count == 0) {
+            Capture_Sum_Period = 0;
+            Capture_Sum_High = 0;
+        }
+        Capture_Rise = now;
+        Capture_Have_Rise = 1;
+        TCCR1B &= ~(1 << ICES1);
+    } else {
+        Capture_Fall = now;
+        TCCR1B |= (1 << ICES1);
+    }
+    // Changing the edge can set ICF1 on its own
+    TIFR = (1 << ICF1);
+}
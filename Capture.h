@@ -0,0 +1,51 @@
+/*
+ * File:   Capture.h
+ * Author: Mostafa Eshra
+ *
+ * Description: Measures a PWM signal looped back into ICP1 (PD6) with the
+ *              Timer1 input capture unit: period and high time from edge
+ *              timestamps, duty and frequency in fixed point.
+ *
+ * Timer1 must run in TIMER1_MODE_FPWM_10BIT (fixed TOP = 0x3FF, ICR1 free)
+ * with TIMER1_CS_NO_PRE. Its overflow count extends ICR1 to a 26-bit
+ * timestamp with 62.5 ns resolution that wraps every ~4.2 s.
+ */
+
+#ifndef CAPTURE_H
+#define	CAPTURE_H
+
+#include <stdint.h>
+
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+// Timer1 counts per overflow (TOP + 1) and per second
+#define CAPTURE_TIMER1_STEPS      1024UL
+#define CAPTURE_TIMER1_HZ         F_CPU
+
+// No edge for this many Timer1 overflows (~66 ms) -> constant level (0/100%)
+#define CAPTURE_IDLE_OVERFLOWS    1024
+
+// Results are averaged over CAPTURE_AVERAGE_PERIODS periods, one full
+// Timer0 dither cycle (256 PWM periods with the fraction spread over them),
+// so a dithered duty reads steady instead of jumping between two steps.
+// Slow signals publish early, once the window spans CAPTURE_AVERAGE_COUNTS.
+// Both limits keep the sums and F_CPU * periods inside 32 bits.
+#define CAPTURE_AVERAGE_PERIODS   256
+#define CAPTURE_AVERAGE_COUNTS    0x00800000UL    // ~0.52 s
+
+typedef struct {
+    uint32_t period;          // Timer1 counts (window average), 0 if there is no signal
+    uint32_t high;            // Timer1 counts (window average)
+    uint32_t freq_hz;         // 0 if there is no signal
+    uint16_t duty_permille;   // 0-1000, also set for a constant level
+} Capture_Result;
+
+// Enables the capture (noise canceler on) and Timer1 overflow interrupts,
+// needs sei()
+void Capture_Init(void);
+// Latest complete averaging window
+void Capture_Get(Capture_Result* result);
+
+#endif	/* CAPTURE_H */
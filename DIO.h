@@ -31,6 +31,28 @@ void DIO_Set_PIN_VALUE(volatile unsigned char* PORTx,char PIN, char Val);
 void DIO_Read_PIN(volatile unsigned char * PORTx, char PIN, char* val);
 void DIO_Toggle_PIN(volatile unsigned char* PORTx, char PIN);
 
+
+// --- Compile-Time Pin Access ---
+// Take the register itself (PORTA, DDRA, PINA ...) and a constant pin number,
+// so the compiler resolves everything and can emit a single sbi/cbi/sbic/in/out
+// instead of a call with a runtime switch and pointer arithmetic (all port
+// registers of the ATmega32 sit below I/O address 0x20, in sbi/cbi range).
+// make host-bench costs one GLCD bus byte both ways on the host model
+// ("bus byte" rows, estimated cycles); the listing (avr-objdump -d) of the
+// actual build has the exact figures.
+// PINx is the input register (the DIO_Read_* functions reach it as PORTx-2).
+
+#define DIO_FAST_PIN_OUTPUT(DDRx, PIN)    ((DDRx) |= (1 << (PIN)))
+#define DIO_FAST_PIN_INPUT(DDRx, PIN)     ((DDRx) &= ~(1 << (PIN)))
+#define DIO_FAST_PIN_HIGH(PORTx, PIN)     ((PORTx) |= (1 << (PIN)))
+#define DIO_FAST_PIN_LOW(PORTx, PIN)      ((PORTx) &= ~(1 << (PIN)))
+#define DIO_FAST_PIN_TOGGLE(PORTx, PIN)   ((PORTx) ^= (1 << (PIN)))
+#define DIO_FAST_PIN_READ(PINx, PIN)      (((PINx) & (1 << (PIN))) ? HIGH : LOW)
+
+#define DIO_FAST_PORT_DIR(DDRx, DIR)      ((DDRx) = (DIR))
+#define DIO_FAST_PORT_WRITE(PORTx, Val)   ((PORTx) = (Val))
+#define DIO_FAST_PORT_READ(PINx)          (PINx)
+
 #endif // DIO_H_INCLUDED
 
 #endif	/* DIO_H */
\ No newline at end of file
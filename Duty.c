@@ -0,0 +1,21 @@
+/* 
+ * File:   Duty.c
+ * Author: Mostafa Eshra
+ */
+
+#include "Duty.h"
+
+uint8_t Duty_To_OCR(uint16_t adc_val){
+    return (uint8_t)(adc_val >> 2);
+}
+
+uint8_t Duty_To_Percent(uint16_t adc_val){
+    // adc * 100 <= 102300, well inside the exact range of DUTY_DIV_1023
+    return (uint8_t)DUTY_DIV_1023((uint32_t)adc_val * 100);
+}
+
+uint8_t Duty_To_Width(uint16_t adc_val, uint8_t width){
+    // round(a*w/1023) = floor((2*a*w + 1023) / 2046)
+    uint32_t x = ((uint32_t)adc_val * width * 2) + DUTY_ADC_MAX;
+    return (uint8_t)(DUTY_DIV_1023(x) >> 1);
+}
@@ -0,0 +1,29 @@
+/* 
+ * File:   Duty.h
+ * Author: Mostafa Eshra
+ *
+ * Description: Fixed-point scaling of a 10-bit ADC code to PWM compare value,
+ *              duty percentage and waveform width (no float, no libm).
+ */
+
+#ifndef DUTY_H
+#define	DUTY_H
+
+#include <stdint.h>
+
+// Full-scale ADC code
+#define DUTY_ADC_MAX        1023
+
+// floor(x / 1023) without a divide, exact for 0 <= x < 2^20 - 1:
+// 1/1023 = 1/1024 * (1 + 1/1024 + 1/1024^2 + ...), the "+1" covers the tail
+#define DUTY_DIV_1023(x)    (((uint32_t)(x) + ((uint32_t)(x) >> 10) + 1) >> 10)
+
+// 8-bit compare value for OCR0 (adc / 4)
+uint8_t Duty_To_OCR(uint16_t adc_val);
+// Duty cycle in percent, truncated: same as (uint8_t)((adc/1023.0) * 100)
+uint8_t Duty_To_Percent(uint16_t adc_val);
+// High part of a waveform period of width columns (width <= 255), rounded:
+// same as round((adc/1023.0) * width)
+uint8_t Duty_To_Width(uint16_t adc_val, uint8_t width);
+
+#endif	/* DUTY_H */
@@ -0,0 +1,31 @@
+/*
+ * File:   Filter.c
+ * Author: Mostafa Eshra
+ */
+
+#include "Filter.h"
+
+#if FILTER_TYPE == FILTER_OVERSAMPLE
+uint16_t Filter_Sum[FILTER_CHANNELS];
+uint8_t  Filter_Count[FILTER_CHANNELS];
+#elif FILTER_TYPE == FILTER_IIR
+uint16_t Filter_State[FILTER_CHANNELS];
+uint8_t  Filter_Primed = 0;
+#elif FILTER_TYPE == FILTER_BOXCAR
+uint16_t Filter_History[FILTER_CHANNELS][FILTER_BOXCAR_LEN];
+uint16_t Filter_Sum[FILTER_CHANNELS];
+uint8_t  Filter_Pos[FILTER_CHANNELS];
+uint8_t  Filter_Primed = 0;
+#endif
+
+void Filter_Reset(void){
+#if FILTER_TYPE == FILTER_OVERSAMPLE
+    for (uint8_t ch = 0; ch < FILTER_CHANNELS; ch++) {
+        Filter_Sum[ch] = 0;
+        Filter_Count[ch] = 0;
+    }
+#elif FILTER_TYPE == FILTER_IIR || FILTER_TYPE == FILTER_BOXCAR
+    // The next sample of each channel re-seeds it
+    Filter_Primed = 0;
+#endif
+}
@@ -0,0 +1,131 @@
+/*
+ * File:   Filter.h
+ * Author: Mostafa Eshra
+ *
+ * Description: Integer filter stage between the ADC ISR and its consumers.
+ *              One filter is chosen at compile time (FILTER_TYPE); the others
+ *              are not built. Filter_Push() is inline so the ADC ISR does not
+ *              pay for a call (an ISR calling a function saves every
+ *              call-clobbered register).
+ *
+ * Cost per sample in the ISR (avr-gcc -Os, ATmega32, approximate):
+ *   FILTER_NONE        ~2 cycles
+ *   FILTER_OVERSAMPLE  ~30 cycles, ~45 on the decimating sample
+ *   FILTER_IIR         ~25 + 6 * FILTER_IIR_SHIFT cycles
+ *   FILTER_BOXCAR      ~45 + 6 * FILTER_BOXCAR_SHIFT cycles
+ * The fastest 10-bit conversion (200 kHz ADC clock, 15.4 kSa/s) leaves
+ * ~1000 cycles per sample, so each of them fits with a wide margin.
+ */
+
+#ifndef FILTER_H
+#define	FILTER_H
+
+#include <stdint.h>
+#include "ADC.h"
+
+#define FILTER_NONE         0
+#define FILTER_OVERSAMPLE   1   // 4^n samples summed, >> n: +n bits, rate / 4^n
+#define FILTER_IIR          2   // y += (x - y) / 2^k, state kept with k extra bits
+#define FILTER_BOXCAR       3   // Mean of the last 2^k samples (running sum)
+
+#ifndef FILTER_TYPE
+#define FILTER_TYPE         FILTER_OVERSAMPLE
+#endif
+
+// FILTER_OVERSAMPLE: n (1..3), 4^n samples per output, output is 10 + n bits
+#define FILTER_OVERSAMPLE_N     2
+// FILTER_IIR: k (1..6), time constant ~2^k samples
+#define FILTER_IIR_SHIFT        3
+// FILTER_BOXCAR: k (1..4), window of 2^k samples (2^k * 2 bytes per channel)
+#define FILTER_BOXCAR_SHIFT     3
+
+// One filter per scan list entry (entry 0 in ring buffer mode)
+#define FILTER_CHANNELS         ADC_SCAN_MAX_CHANNELS
+
+// Resolution of the filtered value
+#if FILTER_TYPE == FILTER_OVERSAMPLE
+#define FILTER_BITS             (10 + FILTER_OVERSAMPLE_N)
+#else
+#define FILTER_BITS             10
+#endif
+#define FILTER_TO_10BIT(x)      ((uint16_t)(x) >> (FILTER_BITS - 10))
+
+// --- Filter State (Filter.c, written by the ADC ISR only) ---
+#if FILTER_TYPE == FILTER_OVERSAMPLE
+extern uint16_t Filter_Sum[FILTER_CHANNELS];
+extern uint8_t  Filter_Count[FILTER_CHANNELS];
+#elif FILTER_TYPE == FILTER_IIR
+extern uint16_t Filter_State[FILTER_CHANNELS];
+extern uint8_t  Filter_Primed;
+#elif FILTER_TYPE == FILTER_BOXCAR
+#define FILTER_BOXCAR_LEN       (1 << FILTER_BOXCAR_SHIFT)
+extern uint16_t Filter_History[FILTER_CHANNELS][FILTER_BOXCAR_LEN];
+extern uint16_t Filter_Sum[FILTER_CHANNELS];
+extern uint8_t  Filter_Pos[FILTER_CHANNELS];
+extern uint8_t  Filter_Primed;
+#endif
+
+// Clears every channel (call with the ADC interrupt off)
+void Filter_Reset(void);
+
+// Feeds one 10-bit sample of channel ch. Returns 1 and writes *out
+// (FILTER_BITS wide) when an output is due, 0 while decimating.
+static inline uint8_t Filter_Push(uint8_t ch, uint16_t sample, uint16_t* out) {
+#if FILTER_TYPE == FILTER_OVERSAMPLE
+    // 64 * 1023 fits in 16 bits, enough for n <= 3
+    uint16_t sum = Filter_Sum[ch] + sample;
+    if (++Filter_Count[ch] < (1 << (2 * FILTER_OVERSAMPLE_N))) {
+        Filter_Sum[ch] = sum;
+        return 0;
+    }
+    Filter_Sum[ch] = 0;
+    Filter_Count[ch] = 0;
+    *out = sum >> FILTER_OVERSAMPLE_N;
+    return 1;
+
+#elif FILTER_TYPE == FILTER_IIR
+    uint8_t bit = (uint8_t)(1 << ch);
+    uint16_t state;
+    if (!(Filter_Primed & bit)) {
+        // Start at the first sample instead of ramping up from 0
+        Filter_Primed |= bit;
+        state = sample << FILTER_IIR_SHIFT;
+    } else {
+        // state = y * 2^k: y += (x - y) / 2^k becomes state += x - state / 2^k
+        state = Filter_State[ch];
+        state += sample - (state >> FILTER_IIR_SHIFT);
+    }
+    Filter_State[ch] = state;
+    // Rounded back to 10 bits
+    *out = (state + (1 << (FILTER_IIR_SHIFT - 1))) >> FILTER_IIR_SHIFT;
+    return 1;
+
+#elif FILTER_TYPE == FILTER_BOXCAR
+    uint8_t bit = (uint8_t)(1 << ch);
+    uint8_t pos = Filter_Pos[ch];
+    uint16_t sum;
+    if (!(Filter_Primed & bit)) {
+        // Fill the window with the first sample
+        Filter_Primed |= bit;
+        for (uint8_t i = 0; i < FILTER_BOXCAR_LEN; i++) {
+            Filter_History[ch][i] = sample;
+        }
+        sum = sample << FILTER_BOXCAR_SHIFT;
+    } else {
+        // Running sum: add the newest, drop the oldest
+        sum = Filter_Sum[ch] + sample - Filter_History[ch][pos];
+        Filter_History[ch][pos] = sample;
+    }
+    Filter_Sum[ch] = sum;
+    Filter_Pos[ch] = (pos + 1) & (FILTER_BOXCAR_LEN - 1);
+    *out = sum >> FILTER_BOXCAR_SHIFT;
+    return 1;
+
+#else
+    (void)ch;
+    *out = sample;
+    return 1;
+#endif
+}
+
+#endif	/* FILTER_H */
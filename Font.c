@@ -0,0 +1,143 @@
+/*
+ * File:   Font.c
+ * Author: Mostafa Eshra
+ */
+
+#include "Font.h"
+#include "GLCD.h"
+#include "Font_Data.h"
+
+const Font Font_Small = { Font_Small_Glyphs, Font_Small_Data, 8, ' ', '~', 1 };
+const Font Font_Digits_16 = { Font_Digits_16_Glyphs, Font_Digits_16_Data, 16, ' ', '9', 2 };
+
+// Decoder state of one glyph: Font_Next_Column() returns one column per
+// call, so no glyph or string is ever unpacked into a buffer
+typedef struct {
+    const uint8_t* data;    // Flash, next byte to read
+    uint16_t run;           // RLE: pixels left in the current run
+    uint8_t rle;
+    uint8_t high_nibble;    // RLE: the next nibble is the high one of *data
+    uint8_t color;          // RLE: color of the current run
+} Font_Stream;
+
+// Width of ch, and its stream set up at the first column
+static uint8_t Font_Open(const Font* font, char ch, Font_Stream* stream) {
+    const Font_Glyph* glyph = &font->glyphs[0];
+    uint8_t width = 0;
+
+    if (ch >= font->first && ch <= font->last) {
+        glyph = &font->glyphs[(uint8_t)(ch - font->first)];
+        width = pgm_read_byte(&glyph->width);
+    }
+    if (width == 0) {
+        // Not in the font: first glyph instead
+        glyph = &font->glyphs[0];
+        width = pgm_read_byte(&glyph->width);
+    }
+
+    uint16_t offset = pgm_read_word(&glyph->offset);
+    stream->data = &font->data[offset & ~FONT_GLYPH_RLE];
+    stream->rle = (offset & FONT_GLYPH_RLE) != 0;
+    stream->run = 0;
+    stream->high_nibble = 1;
+    stream->color = 1;      // The first run toggles it to clear
+    return width;
+}
+
+static uint8_t Font_Next_Nibble(Font_Stream* stream) {
+    uint8_t data = pgm_read_byte(stream->data);
+    if (stream->high_nibble) {
+        stream->high_nibble = 0;
+        return data >> 4;
+    }
+    stream->high_nibble = 1;
+    stream->data++;
+    return data & 0x0F;
+}
+
+// Next column of the glyph, bit 0 = top row
+static uint32_t Font_Next_Column(Font_Stream* stream, uint8_t height) {
+    uint32_t bits = 0;
+
+    if (!stream->rle) {
+        for (uint8_t shift = 0; shift < height; shift += 8) {
+            bits |= (uint32_t)pgm_read_byte(stream->data++) << shift;
+        }
+        return bits;
+    }
+
+    for (uint8_t row = 0; row < height; row++) {
+        // Runs may be empty (a glyph starting with a set pixel)
+        while (stream->run == 0) {
+            uint8_t nibble;
+            do {
+                nibble = Font_Next_Nibble(stream);
+                stream->run += nibble;
+            } while (nibble == 15);
+            stream->color ^= 1;
+        }
+        if (stream->color) {
+            bits |= (uint32_t)1 << row;
+        }
+        stream->run--;
+    }
+    return bits;
+}
+
+// Writes the height rows of one column with its top at pixel row y: whole
+// pages as plain bytes, the partial top and bottom ones merged
+static void Font_Put_Column(uint8_t x, uint8_t y, uint32_t bits, uint8_t height) {
+    uint32_t mask = (((uint32_t)1 << height) - 1) << (y & 7);
+    bits <<= (y & 7);
+
+    for (uint8_t page = y >> 3; mask != 0 && page < GLCD_PAGES; page++) {
+        uint8_t keep = ~(uint8_t)mask;
+        uint8_t data = (uint8_t)bits;
+        if (keep != 0) {
+            data |= GLCD_ReadByte(page, x) & keep;
+        }
+        GLCD_WriteByte(page, x, data);
+        mask >>= 8;
+        bits >>= 8;
+    }
+}
+
+uint8_t Font_Char_Width(const Font* font, char ch) {
+    Font_Stream stream;
+    return Font_Open(font, ch, &stream);
+}
+
+uint16_t Font_String_Width(const Font* font, const char* str) {
+    uint16_t width = 0;
+
+    for (const char* p = str; *p != '\0'; p++) {
+        if (p != str) {
+            width += font->spacing;
+        }
+        width += Font_Char_Width(font, *p);
+    }
+    return width;
+}
+
+uint16_t Font_Draw_Char(const Font* font, uint16_t x, uint8_t y, char ch) {
+    Font_Stream stream;
+    uint8_t width = Font_Open(font, ch, &stream);
+
+    for (uint8_t c = 0; c < width && x + c < GLCD_WIDTH; c++) {
+        Font_Put_Column(x + c, y, Font_Next_Column(&stream, font->height), font->height);
+    }
+    return x + width;
+}
+
+uint16_t Font_Draw_String(const Font* font, uint16_t x, uint8_t y, const char* str) {
+    for (const char* p = str; *p != '\0' && x < GLCD_WIDTH; p++) {
+        if (p != str) {
+            // Blank gap, so the text also replaces what was there
+            for (uint8_t s = 0; s < font->spacing && x < GLCD_WIDTH; s++) {
+                Font_Put_Column(x++, y, 0, font->height);
+            }
+        }
+        x = Font_Draw_Char(font, x, y, *p);
+    }
+    return x;
+}
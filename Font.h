@@ -0,0 +1,71 @@
+/*
+ * File:   Font.h
+ * Author: Mostafa Eshra
+ *
+ * Description: Proportional font engine for the GLCD framebuffer. Every
+ *              glyph has its own width, the glyph data stays in flash
+ *              (optionally run-length coded, see Font_Data.h) and is decoded
+ *              one column at a time straight into the framebuffer.
+ *
+ * Text goes at any pixel y: a glyph column is shifted across the pages it
+ * straddles. Fonts may be up to FONT_MAX_HEIGHT rows, so large digits span
+ * two or three pages. Columns are plain framebuffer columns, so text runs
+ * across the chip boundary at column 64 without a gap.
+ */
+
+#ifndef FONT_H
+#define	FONT_H
+
+#include <stdint.h>
+
+#if defined(__AVR__)
+#include <avr/pgmspace.h>
+#else
+// Host builds: the tables are ordinary const arrays
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#define pgm_read_byte(p)   (*(const uint8_t*)(p))
+#define pgm_read_word(p)   (*(const uint16_t*)(p))
+#endif
+
+// Tallest supported font: a shifted column must fit 32 bits (24 + 7)
+#define FONT_MAX_HEIGHT    24
+
+// Set in Font_Glyph.offset when the glyph is run-length coded
+#define FONT_GLYPH_RLE     0x8000
+
+typedef struct {
+    uint16_t offset;        // Into the font's data, | FONT_GLYPH_RLE when RLE coded
+    uint8_t width;          // Columns, 0 = not in this font
+} Font_Glyph;
+
+typedef struct {
+    const Font_Glyph* glyphs;   // Flash, one per character first..last
+    const uint8_t* data;        // Flash
+    uint8_t height;             // Rows (1..FONT_MAX_HEIGHT)
+    char first;
+    char last;
+    uint8_t spacing;            // Blank columns between two glyphs
+} Font;
+
+// Proportional 8-row font (the GLCD_Font.h glyphs with blank columns trimmed)
+extern const Font Font_Small;
+// 16-row digits, '%', '-', '.' and a digit-wide space
+extern const Font Font_Digits_16;
+
+// Characters missing from a font are drawn as its first glyph (space)
+uint8_t Font_Char_Width(const Font* font, char ch);
+// Width of a whole string, spacing between the glyphs included
+uint16_t Font_String_Width(const Font* font, const char* str);
+
+// Draws into the framebuffer with the top row of the glyph at pixel row y.
+// Opaque: the glyph's rows of its columns are cleared where it has no
+// pixels, the rest of those columns is left alone. Clipped to the display.
+// Both return the column right after the glyph (Font_Draw_Char, spacing
+// not drawn) or after the last glyph (Font_Draw_String, no trailing
+// spacing), which may lie past the right edge.
+uint16_t Font_Draw_Char(const Font* font, uint16_t x, uint8_t y, char ch);
+uint16_t Font_Draw_String(const Font* font, uint16_t x, uint8_t y, const char* str);
+
+#endif	/* FONT_H */
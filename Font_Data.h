@@ -0,0 +1,387 @@
+/*
+ * File:   Font_Data.h
+ * Author: Mostafa Eshra
+ *
+ * Description: Glyph tables of the Font.h fonts, kept in flash. Included by
+ *              Font.c only.
+ *
+ * Each glyph is stored column by column, left to right, either
+ *  - raw: ceil(height / 8) bytes per column, LSB = top row, or
+ *  - RLE (offset | FONT_GLYPH_RLE): the column bits top to bottom, one
+ *    column after the other, as alternating runs of clear and set pixels
+ *    (starting with clear). One run per nibble, high nibble first; a nibble
+ *    of 15 adds 15 and the run continues in the next nibble.
+ * A glyph is RLE coded only when that is shorter than raw: large glyphs with
+ * solid strokes shrink, 8-row glyphs hardly ever do.
+ */
+
+#ifndef FONT_DATA_H
+#define	FONT_DATA_H
+
+#include "Font.h"
+
+// --- Font_Small: proportional, 8 rows ---
+// The FONT_DATA glyphs (GLCD_Font.h) with their blank columns trimmed
+static const uint8_t Font_Small_Data[] PROGMEM = {
+    // Space (0x20) RLE
+    0xF1,
+    // ! (0x21)
+    0x5F,
+    // " (0x22)
+    0x07, 0x00, 0x07,
+    // # (0x23)
+    0x14, 0x7F, 0x14, 0x7F, 0x14,
+    // $ (0x24)
+    0x24, 0x2A, 0x7F, 0x2A, 0x12,
+    // % (0x25)
+    0x23, 0x13, 0x08, 0x64, 0x62,
+    // & (0x26)
+    0x36, 0x49, 0x55, 0x22, 0x50,
+    // ' (0x27)
+    0x05, 0x03,
+    // ( (0x28)
+    0x1C, 0x22, 0x41,
+    // ) (0x29)
+    0x41, 0x22, 0x1C,
+    // * (0x2A)
+    0x14, 0x08, 0x3E, 0x08, 0x14,
+    // + (0x2B)
+    0x08, 0x08, 0x3E, 0x08, 0x08,
+    // , (0x2C)
+    0x50, 0x30,
+    // - (0x2D)
+    0x08, 0x08, 0x08, 0x08, 0x08,
+    // . (0x2E)
+    0x60, 0x60,
+    // / (0x2F)
+    0x20, 0x10, 0x08, 0x04, 0x02,
+    // 0 (0x30)
+    0x3E, 0x51, 0x49, 0x45, 0x3E,
+    // 1 (0x31)
+    0x42, 0x7F, 0x40,
+    // 2 (0x32)
+    0x42, 0x61, 0x51, 0x49, 0x46,
+    // 3 (0x33)
+    0x21, 0x41, 0x45, 0x4B, 0x31,
+    // 4 (0x34)
+    0x18, 0x14, 0x12, 0x7F, 0x10,
+    // 5 (0x35)
+    0x27, 0x45, 0x45, 0x45, 0x39,
+    // 6 (0x36)
+    0x3C, 0x4A, 0x49, 0x49, 0x30,
+    // 7 (0x37)
+    0x01, 0x71, 0x09, 0x05, 0x03,
+    // 8 (0x38)
+    0x36, 0x49, 0x49, 0x49, 0x36,
+    // 9 (0x39)
+    0x06, 0x49, 0x49, 0x29, 0x1E,
+    // : (0x3A)
+    0x36, 0x36,
+    // ; (0x3B)
+    0x56,
+    // < (0x3C)
+    0x30,
+    // = (0x3D)
+    0x14, 0x14, 0x14,
+    // > (0x3E)
+    0x30,
+    // ? (0x3F)
+    0x02, 0x01, 0x51, 0x09, 0x06,
+    // @ (0x40)
+    0x3E, 0x41, 0x59, 0x4A, 0x7E,
+    // A (0x41)
+    0x7E, 0x11, 0x11, 0x11, 0x7E,
+    // B (0x42)
+    0x7F, 0x49, 0x49, 0x49, 0x36,
+    // C (0x43)
+    0x3E, 0x41, 0x41, 0x41, 0x22,
+    // D (0x44)
+    0x7F, 0x41, 0x41, 0x22, 0x1C,
+    // E (0x45)
+    0x7F, 0x49, 0x49, 0x49, 0x41,
+    // F (0x46)
+    0x7F, 0x09, 0x09, 0x09, 0x01,
+    // G (0x47)
+    0x3E, 0x41, 0x49, 0x49, 0x7A,
+    // H (0x48)
+    0x7F, 0x08, 0x08, 0x08, 0x7F,
+    // I (0x49)
+    0x41, 0x7F, 0x41,
+    // J (0x4A)
+    0x20, 0x40, 0x41, 0x3F, 0x01,
+    // K (0x4B)
+    0x7F, 0x08, 0x14, 0x22, 0x41,
+    // L (0x4C)
+    0x7F, 0x40, 0x40, 0x40, 0x40,
+    // M (0x4D)
+    0x7F, 0x02, 0x0C, 0x02, 0x7F,
+    // N (0x4E)
+    0x7F, 0x04, 0x08, 0x10, 0x7F,
+    // O (0x4F)
+    0x3E, 0x41, 0x41, 0x41, 0x3E,
+    // P (0x50)
+    0x7F, 0x09, 0x09, 0x09, 0x06,
+    // Q (0x51)
+    0x3E, 0x41, 0x51, 0x21, 0x5E,
+    // R (0x52)
+    0x7F, 0x09, 0x19, 0x29, 0x46,
+    // S (0x53)
+    0x46, 0x49, 0x49, 0x49, 0x31,
+    // T (0x54)
+    0x01, 0x01, 0x7F, 0x01, 0x01,
+    // U (0x55)
+    0x3F, 0x40, 0x40, 0x40, 0x3F,
+    // V (0x56)
+    0x1F, 0x20, 0x40, 0x20, 0x1F,
+    // W (0x57)
+    0x3F, 0x40, 0x38, 0x40, 0x3F,
+    // X (0x58)
+    0x63, 0x14, 0x08, 0x14, 0x63,
+    // Y (0x59)
+    0x07, 0x08, 0x70, 0x08, 0x07,
+    // Z (0x5A)
+    0x61, 0x51, 0x49, 0x45, 0x43,
+    // [ (0x5B)
+    0x7F, 0x41, 0x41, 0x41,
+    // Backslash (0x5C)
+    0x08, 0x10, 0x20, 0x40,
+    // ] (0x5D)
+    0x41, 0x41, 0x41, 0x7F,
+    // ^ (0x5E)
+    0x04, 0x02, 0x01, 0x02, 0x04,
+    // _ (0x5F)
+    0x40, 0x40, 0x40, 0x40, 0x40,
+    // ` (0x60)
+    0x01, 0x02, 0x04,
+    // a (0x61)
+    0x20, 0x54, 0x54, 0x54, 0x78,
+    // b (0x62)
+    0x7F, 0x48, 0x44, 0x44, 0x38,
+    // c (0x63)
+    0x38, 0x44, 0x44, 0x44, 0x20,
+    // d (0x64)
+    0x38, 0x44, 0x44, 0x48, 0x7F,
+    // e (0x65)
+    0x38, 0x54, 0x54, 0x54, 0x18,
+    // f (0x66)
+    0x08, 0x7E, 0x09, 0x01, 0x02,
+    // g (0x67)
+    0x0C, 0x52, 0x52, 0x52, 0x3E,
+    // h (0x68)
+    0x7F, 0x08, 0x04, 0x04, 0x78,
+    // i (0x69)
+    0x44, 0x7D, 0x40,
+    // j (0x6A)
+    0x20, 0x40, 0x44, 0x3D,
+    // k (0x6B)
+    0x7F, 0x10, 0x28, 0x44,
+    // l (0x6C)
+    0x41, 0x7F, 0x40,
+    // m (0x6D)
+    0x7C, 0x04, 0x18, 0x04, 0x78,
+    // n (0x6E)
+    0x7C, 0x08, 0x04, 0x04, 0x78,
+    // o (0x6F)
+    0x38, 0x44, 0x44, 0x44, 0x38,
+    // p (0x70)
+    0x7C, 0x14, 0x14, 0x14, 0x08,
+    // q (0x71)
+    0x08, 0x14, 0x14, 0x18, 0x7C,
+    // r (0x72)
+    0x7C, 0x08, 0x04, 0x04, 0x08,
+    // s (0x73)
+    0x48, 0x54, 0x54, 0x54, 0x20,
+    // t (0x74)
+    0x04, 0x3F, 0x44, 0x40, 0x20,
+    // u (0x75)
+    0x3C, 0x40, 0x40, 0x20, 0x7C,
+    // v (0x76)
+    0x1C, 0x20, 0x40, 0x20, 0x1C,
+    // w (0x77)
+    0x3C, 0x40, 0x30, 0x40, 0x3C,
+    // x (0x78)
+    0x44, 0x28, 0x10, 0x28, 0x44,
+    // y (0x79)
+    0x0C, 0x50, 0x50, 0x50, 0x3C,
+    // z (0x7A)
+    0x44, 0x64, 0x54, 0x4C, 0x44,
+    // { (0x7B)
+    0x40, 0x20, 0x40,
+    // | (0x7C)
+    0x7F,
+    // } (0x7D)
+    0x40, 0x20, 0x40,
+    // ~ (0x7E)
+    0x04, 0x02, 0x04, 0x02,
+};
+
+static const Font_Glyph Font_Small_Glyphs[] PROGMEM = {
+    { 0 | FONT_GLYPH_RLE, 2 },   // Space
+    { 1, 1 },   // !
+    { 2, 3 },   // "
+    { 5, 5 },   // #
+    { 10, 5 },   // $
+    { 15, 5 },   // %
+    { 20, 5 },   // &
+    { 25, 2 },   // '
+    { 27, 3 },   // (
+    { 30, 3 },   // )
+    { 33, 5 },   // *
+    { 38, 5 },   // +
+    { 43, 2 },   // ,
+    { 45, 5 },   // -
+    { 50, 2 },   // .
+    { 52, 5 },   // /
+    { 57, 5 },   // 0
+    { 62, 3 },   // 1
+    { 65, 5 },   // 2
+    { 70, 5 },   // 3
+    { 75, 5 },   // 4
+    { 80, 5 },   // 5
+    { 85, 5 },   // 6
+    { 90, 5 },   // 7
+    { 95, 5 },   // 8
+    { 100, 5 },   // 9
+    { 105, 2 },   // :
+    { 107, 1 },   // ;
+    { 108, 1 },   // <
+    { 109, 3 },   // =
+    { 112, 1 },   // >
+    { 113, 5 },   // ?
+    { 118, 5 },   // @
+    { 123, 5 },   // A
+    { 128, 5 },   // B
+    { 133, 5 },   // C
+    { 138, 5 },   // D
+    { 143, 5 },   // E
+    { 148, 5 },   // F
+    { 153, 5 },   // G
+    { 158, 5 },   // H
+    { 163, 3 },   // I
+    { 166, 5 },   // J
+    { 171, 5 },   // K
+    { 176, 5 },   // L
+    { 181, 5 },   // M
+    { 186, 5 },   // N
+    { 191, 5 },   // O
+    { 196, 5 },   // P
+    { 201, 5 },   // Q
+    { 206, 5 },   // R
+    { 211, 5 },   // S
+    { 216, 5 },   // T
+    { 221, 5 },   // U
+    { 226, 5 },   // V
+    { 231, 5 },   // W
+    { 236, 5 },   // X
+    { 241, 5 },   // Y
+    { 246, 5 },   // Z
+    { 251, 4 },   // [
+    { 255, 4 },   // Backslash
+    { 259, 4 },   // ]
+    { 263, 5 },   // ^
+    { 268, 5 },   // _
+    { 273, 3 },   // `
+    { 276, 5 },   // a
+    { 281, 5 },   // b
+    { 286, 5 },   // c
+    { 291, 5 },   // d
+    { 296, 5 },   // e
+    { 301, 5 },   // f
+    { 306, 5 },   // g
+    { 311, 5 },   // h
+    { 316, 3 },   // i
+    { 319, 4 },   // j
+    { 323, 4 },   // k
+    { 327, 3 },   // l
+    { 330, 5 },   // m
+    { 335, 5 },   // n
+    { 340, 5 },   // o
+    { 345, 5 },   // p
+    { 350, 5 },   // q
+    { 355, 5 },   // r
+    { 360, 5 },   // s
+    { 365, 5 },   // t
+    { 370, 5 },   // u
+    { 375, 5 },   // v
+    { 380, 5 },   // w
+    { 385, 5 },   // x
+    { 390, 5 },   // y
+    { 395, 5 },   // z
+    { 400, 3 },   // {
+    { 403, 1 },   // |
+    { 404, 3 },   // }
+    { 407, 4 },   // ~
+};
+
+
+// --- Font_Digits_16: 16 rows, for large numbers ---
+// Digits, space (as wide as a digit so padded numbers keep their place),
+// '%', '-' and '.'; the other codes between are not in the font
+static const uint8_t Font_Digits_16_Data[] PROGMEM = {
+    // Space (0x20) RLE
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xA0,
+    // % (0x25) RLE
+    0x12, 0xB6, 0x94, 0x21, 0x82, 0x24, 0x72, 0x42, 0x63, 0xB4, 0xA4, 0xB3, 0x62, 0x42, 0x74, 0x22,
+    0x81, 0x24, 0x96, 0xB2, 0x10,
+    // - (0x2D) RLE
+    0x72, 0xE2, 0xE2, 0xE2, 0xE2, 0xE2, 0xE2, 0x70,
+    // . (0x2E) RLE
+    0xE2, 0xE2,
+    // 0 (0x30) RLE
+    0x2C, 0x3E, 0x13, 0xA5, 0xC4, 0xC4, 0xC4, 0xC5, 0xA3, 0x1E, 0x3C, 0x20,
+    // 1 (0x31) RLE
+    0x21, 0xB2, 0x12, 0xBF, 0xF4, 0xE2, 0xE2,
+    // 2 (0x32) RLE
+    0x12, 0x88, 0x78, 0x73, 0x24, 0x63, 0x34, 0x53, 0x44, 0x43, 0x54, 0x33, 0x69, 0x72, 0x15, 0x82,
+    0x22, 0xA2,
+    // 3 (0x33)
+    0x06, 0x30, 0x07, 0x70, 0x03, 0xE0, 0xC3, 0xC0, 0xC3, 0xC0, 0xC3, 0xC0, 0xC3, 0xC0, 0xE3, 0xE0,
+    0xBF, 0x7F, 0x1E, 0x3F,
+    // 4 (0x34) RLE
+    0x64, 0xB5, 0xA3, 0x12, 0x93, 0x22, 0x83, 0x32, 0x73, 0x42, 0x63, 0x52, 0x6F, 0xF2, 0x82, 0x60,
+    // 5 (0x35)
+    0x7F, 0x30, 0x7F, 0x70, 0x63, 0xE0, 0x63, 0xC0, 0x63, 0xC0, 0x63, 0xC0, 0x63, 0xC0, 0xE3, 0xE0,
+    0xC3, 0x7F, 0x83, 0x3F,
+    // 6 (0x36)
+    0xFC, 0x3F, 0xFE, 0x7F, 0x87, 0xE1, 0xC3, 0xC0, 0xC3, 0xC0, 0xC3, 0xC0, 0xC3, 0xC0, 0xC7, 0xE1,
+    0x86, 0x7F, 0x04, 0x3F,
+    // 7 (0x37) RLE
+    0x02, 0xE2, 0xE2, 0xE2, 0x97, 0x79, 0x55, 0x42, 0x35, 0x62, 0x15, 0x86, 0xA4, 0xC0,
+    // 8 (0x38)
+    0x3C, 0x3F, 0xFE, 0x7F, 0xE7, 0xE1, 0xC3, 0xC0, 0xC3, 0xC0, 0xC3, 0xC0, 0xC3, 0xC0, 0xE7, 0xE1,
+    0xFE, 0x7F, 0x3C, 0x3F,
+    // 9 (0x39)
+    0xFC, 0x20, 0xFE, 0x61, 0x87, 0xE3, 0x03, 0xC3, 0x03, 0xC3, 0x03, 0xC3, 0x03, 0xC3, 0x87, 0xE1,
+    0xFE, 0x7F, 0xFC, 0x3F,
+};
+
+static const Font_Glyph Font_Digits_16_Glyphs[] PROGMEM = {
+    { 0 | FONT_GLYPH_RLE, 10 },   // Space
+    { 6, 0 },   // ! (missing)
+    { 6, 0 },   // " (missing)
+    { 6, 0 },   // # (missing)
+    { 6, 0 },   // $ (missing)
+    { 6 | FONT_GLYPH_RLE, 12 },   // %
+    { 27, 0 },   // & (missing)
+    { 27, 0 },   // ' (missing)
+    { 27, 0 },   // ( (missing)
+    { 27, 0 },   // ) (missing)
+    { 27, 0 },   // * (missing)
+    { 27, 0 },   // + (missing)
+    { 27, 0 },   // , (missing)
+    { 27 | FONT_GLYPH_RLE, 7 },   // -
+    { 35 | FONT_GLYPH_RLE, 2 },   // .
+    { 37, 0 },   // / (missing)
+    { 37 | FONT_GLYPH_RLE, 10 },   // 0
+    { 49 | FONT_GLYPH_RLE, 6 },   // 1
+    { 56 | FONT_GLYPH_RLE, 10 },   // 2
+    { 74, 10 },   // 3
+    { 94 | FONT_GLYPH_RLE, 10 },   // 4
+    { 110, 10 },   // 5
+    { 130, 10 },   // 6
+    { 150 | FONT_GLYPH_RLE, 10 },   // 7
+    { 164, 10 },   // 8
+    { 184, 10 },   // 9
+};
+
+#endif	/* FONT_DATA_H */
@@ -0,0 +1,132 @@
+/* 
+ * File:   Format.c
+ * Author: Mostafa Eshra
+ */
+
+#include "Format.h"
+
+#if defined(__AVR__)
+#include <avr/pgmspace.h>
+#else
+#define PROGMEM
+#define pgm_read_dword(addr)   (*(const uint32_t*)(addr))
+#endif
+
+// Powers of ten, highest first (in flash)
+static const uint32_t Format_Pow10[10] PROGMEM = {
+    1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL,
+    10000UL, 1000UL, 100UL, 10UL, 1UL
+};
+
+// Shared back end for the 16/32-bit versions: magnitude is the absolute value
+static uint8_t Format_Emit(char* buffer, uint32_t magnitude, uint8_t negative,
+                           uint8_t width, uint8_t flags) {
+    uint8_t first = 9;
+    uint8_t len = 0;
+
+    // 1. Count digits: find the highest power of ten not above the value
+    for (uint8_t i = 0; i < 9; i++) {
+        if (magnitude >= pgm_read_dword(&Format_Pow10[i])) {
+            first = i;
+            break;
+        }
+    }
+    uint8_t digits = 10 - first;
+    uint8_t used = digits + (negative ? 1 : 0);
+
+    // 2. Padding and sign
+    if (flags & FORMAT_ZERO_PAD) {
+        if (negative) {
+            buffer[len++] = '-';
+        }
+        for (; used < width; used++) {
+            buffer[len++] = '0';
+        }
+    } else {
+        for (; used < width; used++) {
+            buffer[len++] = ' ';
+        }
+        if (negative) {
+            buffer[len++] = '-';
+        }
+    }
+
+    // 3. Digits, most significant first, by repeated subtraction
+    for (uint8_t i = first; i < 10; i++) {
+        uint32_t pow10 = pgm_read_dword(&Format_Pow10[i]);
+        char digit = '0';
+        while (magnitude >= pow10) {
+            magnitude -= pow10;
+            digit++;
+        }
+        buffer[len++] = digit;
+    }
+
+    if (flags & FORMAT_PERCENT) {
+        buffer[len++] = '%';
+    }
+    buffer[len] = '\0';
+    return len;
+}
+
+uint8_t Format_Number8(char* buffer, uint8_t value, uint8_t width, uint8_t flags) {
+    uint8_t negative = 0;
+    uint8_t len = 0;
+
+    if ((flags & FORMAT_SIGNED) && (int8_t)value < 0) {
+        negative = 1;
+        value = (uint8_t)(0 - value);
+    }
+
+    // 8-bit fast path: at most 2 + 9 + 9 single-byte subtractions
+    uint8_t hundreds = 0, tens = 0;
+    while (value >= 100) { value -= 100; hundreds++; }
+    while (value >= 10)  { value -= 10;  tens++; }
+
+    uint8_t digits = hundreds ? 3 : (tens ? 2 : 1);
+    uint8_t used = digits + negative;
+    char pad = (flags & FORMAT_ZERO_PAD) ? '0' : ' ';
+
+    if (negative && pad == '0') {
+        buffer[len++] = '-';
+    }
+    for (; used < width; used++) {
+        buffer[len++] = pad;
+    }
+    if (negative && pad == ' ') {
+        buffer[len++] = '-';
+    }
+    if (digits == 3) {
+        buffer[len++] = '0' + hundreds;
+    }
+    if (digits >= 2) {
+        buffer[len++] = '0' + tens;
+    }
+    buffer[len++] = '0' + value;
+
+    if (flags & FORMAT_PERCENT) {
+        buffer[len++] = '%';
+    }
+    buffer[len] = '\0';
+    return len;
+}
+
+uint8_t Format_Number16(char* buffer, uint16_t value, uint8_t width, uint8_t flags) {
+    uint8_t negative = 0;
+
+    if ((flags & FORMAT_SIGNED) && (int16_t)value < 0) {
+        negative = 1;
+        value = (uint16_t)(0 - value);
+    }
+    return Format_Emit(buffer, value, negative, width, flags);
+}
+
+uint8_t Format_Number32(char* buffer, uint32_t value, uint8_t width, uint8_t flags) {
+    uint8_t negative = 0;
+
+    if ((flags & FORMAT_SIGNED) && (int32_t)value < 0) {
+        negative = 1;
+        value = 0 - value;
+    }
+    return Format_Emit(buffer, value, negative, width, flags);
+}
@@ -0,0 +1,29 @@
+/* 
+ * File:   Format.h
+ * Author: Mostafa Eshra
+ *
+ * Description: Division-free, fixed-width number formatting for the GLCD.
+ */
+
+#ifndef FORMAT_H
+#define	FORMAT_H
+
+#include <stdint.h>
+
+// Format flags (combine with |)
+#define FORMAT_SIGNED      0x01   // Value is two's complement, print '-' if negative
+#define FORMAT_PERCENT     0x02   // Append '%' after the digits
+#define FORMAT_ZERO_PAD    0x04   // Pad with '0' (after the sign) instead of ' '
+
+// Longest output: sign + 10 digits + '%' + '\0'
+#define FORMAT_MAX_LEN     13
+
+// Each function writes the value right-aligned in at least `width` characters
+// (wider if the number needs it), then the optional '%', then '\0'.
+// Returns the number of characters written, not counting the '\0'.
+// Digits come from subtracting powers of ten, so no divide routine is used.
+uint8_t Format_Number8(char* buffer, uint8_t value, uint8_t width, uint8_t flags);
+uint8_t Format_Number16(char* buffer, uint16_t value, uint8_t width, uint8_t flags);
+uint8_t Format_Number32(char* buffer, uint32_t value, uint8_t width, uint8_t flags);
+
+#endif	/* FORMAT_H */
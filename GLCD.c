@@ -6,242 +6,830 @@
 #include "GLCD.h"
 #include "DIO.h" 
 #include "GLCD_Font.h"
+#include "Format.h"
+#include "Waveform.h"
+#include "Timer.h"
 #include <util/delay.h>
+#include <util/atomic.h>
 #include <avr/io.h>
+#include <avr/interrupt.h>
 #include <stdint.h>
 #include <string.h>
 
+// --- Bus Statistics ---
+// Compiled in only with GLCD_STATS = 1, otherwise the macro is empty
+
+#if GLCD_STATS
+static GLCD_Stats GLCD_Bus_Stats;
+static GLCD_Stats GLCD_Frame_Stats;     // Bus cost of the last GLCD_Flush()
+#if GLCD_QUEUE
+static GLCD_Stats GLCD_Frame_Start;     // Bus counters at the previous frame end
+#endif
+#define GLCD_STAT_ADD(field, n)   (GLCD_Bus_Stats.field += (n))
+#else
+#define GLCD_STAT_ADD(field, n)
+#endif
+
 // --- Internal Helper Functions ---
 
+// Bus sequences use the compile-time DIO_FAST_* macros: every pin access
+// below is a single sbi/cbi/in/out instead of a DIO_Set_PIN_VALUE() call.
+
+// Chip(s) currently asserted by GLCD_AssertChip()
+static uint8_t GLCD_SelectedChip = 0;
+
+// One status read of the asserted chip (bus already in read mode):
+// returns 1 while its Busy Flag (DB7) is HIGH
+static inline uint8_t GLCD_StatusBusy(void) {
+    uint8_t busy_flag;
+
+    // Toggle Enable pin to read the status
+    DIO_FAST_PIN_HIGH(GLCD_CONTROL_PORT_REG, GLCD_E_PIN);
+    _delay_us(1); 
+    busy_flag = DIO_FAST_PIN_READ(GLCD_DATA_PIN_REG, 7); // Read the value of DB7
+    DIO_FAST_PIN_LOW(GLCD_CONTROL_PORT_REG, GLCD_E_PIN);
+    _delay_us(1); 
+    GLCD_STAT_ADD(busy_polls, 1);
+    GLCD_STAT_ADD(strobes, 1);
+    GLCD_STAT_ADD(delay_us, 2);
+    return busy_flag == HIGH;
+}
+
+// Switches the bus to a status read: data port input, RW=HIGH, RS=LOW
+static inline void GLCD_StatusMode(void) {
+    DIO_FAST_PORT_DIR(GLCD_DATA_DDR_REG, INPUT_PORT);
+    DIO_FAST_PIN_HIGH(GLCD_CONTROL_PORT_REG, GLCD_RW_PIN); // Read mode
+    DIO_FAST_PIN_LOW(GLCD_CONTROL_PORT_REG, GLCD_RS_PIN);  // Command mode
+}
+
+// Switches the bus back to writing: data port output, RW=LOW
+static inline void GLCD_WriteMode(void) {
+    DIO_FAST_PORT_DIR(GLCD_DATA_DDR_REG, OUTPUT_PORT);
+    DIO_FAST_PIN_LOW(GLCD_CONTROL_PORT_REG, GLCD_RW_PIN); // Write mode
+}
+
+// Polls the busy flag of the asserted chip until it is ready
+static inline void GLCD_PollBusy(void) {
+    while (GLCD_StatusBusy()) {
+    }
+}
+
+// Waits until the selected chip(s) can take a write, leaves the bus in write mode
+static inline void GLCD_WaitReady(void) {
+    GLCD_StatusMode();
+    if (GLCD_SelectedChip == GLCD_CHIP_BOTH) {
+        // Both chips would drive DB7 together: poll them one at a time.
+        // They work in parallel, so the second poll rarely has to wait.
+        DIO_FAST_PIN_LOW(GLCD_CONTROL_PORT_REG, GLCD_CS2_PIN);
+        GLCD_PollBusy();
+        DIO_FAST_PIN_LOW(GLCD_CONTROL_PORT_REG, GLCD_CS1_PIN);
+        DIO_FAST_PIN_HIGH(GLCD_CONTROL_PORT_REG, GLCD_CS2_PIN);
+        GLCD_PollBusy();
+        DIO_FAST_PIN_HIGH(GLCD_CONTROL_PORT_REG, GLCD_CS1_PIN);
+    } else {
+        GLCD_PollBusy();
+    }
+    GLCD_WriteMode();
+}
+
 // Waits for the controller chip to finish its current operation
 void GLCD_BusyWait(void) {
-    char busy_flag; // Variable to hold the result of the DIO_Read_PIN function
-
-    // 1. Set GLCD data port to input (Use GLCD_DATA_PORT for direction setting)
-    DIO_Set_PORT_DIR(GLCD_DATA_PORT, 0x00);
-    
-    // 2. Control sequence for reading busy flag
-    DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_RW_PIN, HIGH); // Read mode
-    DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_RS_PIN, LOW);  // Command mode
-    
-    // 3. Loop until Busy Flag (DB7) is LOW (not busy)
-    do {
-        // Toggle Enable pin to read the status
-        DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_E_PIN, HIGH);
-        _delay_us(1); 
-        DIO_Read_PIN(GLCD_DATA_PORT, 7, &busy_flag); // Read the value of DB7
-        DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_E_PIN, LOW);
-        _delay_us(1); 
-    } while (busy_flag == HIGH); // Repeat if DB7 (Busy Flag) is HIGH
-    
-    // 4. Set GLCD data port back to output for writing data
-    DIO_Set_PORT_DIR(GLCD_DATA_PORT, 0xFF);
-    
-    // 5. Reset control pins
-    DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_RW_PIN, LOW); // Write mode
+    GLCD_WaitReady();
 }
 
-// Selects the desired chip (CS1 or CS2)
-void GLCD_SelectChip(uint8_t chip) {
+// Drives the chip select lines (CS1, CS2 or both for broadcast writes)
+static inline void GLCD_AssertChip(uint8_t chip) {
     // Disable all chips first
-    DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_CS1_PIN, LOW);
-    DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_CS2_PIN, LOW);
+    DIO_FAST_PIN_LOW(GLCD_CONTROL_PORT_REG, GLCD_CS1_PIN);
+    DIO_FAST_PIN_LOW(GLCD_CONTROL_PORT_REG, GLCD_CS2_PIN);
     
-    // Enable the selected chip
-    if (chip == 1) {
-        DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_CS1_PIN, HIGH);
-    } else if (chip == 2) {
-        DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_CS2_PIN, HIGH);
+    // Enable the selected chip(s)
+    if (chip == GLCD_CHIP_1 || chip == GLCD_CHIP_BOTH) {
+        DIO_FAST_PIN_HIGH(GLCD_CONTROL_PORT_REG, GLCD_CS1_PIN);
+    }
+    if (chip == GLCD_CHIP_2 || chip == GLCD_CHIP_BOTH) {
+        DIO_FAST_PIN_HIGH(GLCD_CONTROL_PORT_REG, GLCD_CS2_PIN);
     }
+    GLCD_SelectedChip = chip;
+    GLCD_STAT_ADD(chip_selects, 1);
+}
+
+// Selects the desired chip (CS1, CS2 or both for broadcast writes)
+void GLCD_SelectChip(uint8_t chip) {
+    GLCD_AssertChip(chip);
     GLCD_BusyWait(); 
 }
 
-// Sends a command byte to the currently selected chip
-void GLCD_Command(uint8_t cmd) {
-    GLCD_BusyWait(); // Wait until the chip is ready
+// One write strobe to the selected chip(s), which must be ready (RW=LOW):
+// RS=LOW for a command, HIGH for data
+static inline void GLCD_BusWrite(uint8_t data_mode, uint8_t value) {
+    if (data_mode) {
+        DIO_FAST_PIN_HIGH(GLCD_CONTROL_PORT_REG, GLCD_RS_PIN);
+        GLCD_STAT_ADD(data_bytes, 1);
+    } else {
+        DIO_FAST_PIN_LOW(GLCD_CONTROL_PORT_REG, GLCD_RS_PIN);
+        GLCD_STAT_ADD(commands, 1);
+    }
 
-    // 1. Control signals: RS=LOW (Command), RW=LOW (Write)
-    DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_RS_PIN, LOW); 
-    DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_RW_PIN, LOW); 
-    
-    // 2. Put data on bus and pulse Enable
-    DIO_Set_PORT_VALUE(GLCD_DATA_PORT, cmd);
-    DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_E_PIN, HIGH);
+    // Put data on bus and pulse Enable
+    DIO_FAST_PORT_WRITE(GLCD_DATA_PORT_REG, value);
+    DIO_FAST_PIN_HIGH(GLCD_CONTROL_PORT_REG, GLCD_E_PIN);
     _delay_us(1); 
-    DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_E_PIN, LOW);
+    DIO_FAST_PIN_LOW(GLCD_CONTROL_PORT_REG, GLCD_E_PIN);
+    GLCD_STAT_ADD(strobes, 1);
+    GLCD_STAT_ADD(delay_us, 1);
 }
 
-// Sends a data byte (pixels) to the currently selected chip
-void GLCD_Data(uint8_t data) {
+// Sends a command byte to the currently selected chip(s)
+void GLCD_Command(uint8_t cmd) {
     GLCD_BusyWait(); // Wait until the chip is ready
+    GLCD_BusWrite(0, cmd);
+}
 
-    // 1. Control signals: RS=HIGH (Data), RW=LOW (Write)
-    DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_RS_PIN, HIGH);
-    DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_RW_PIN, LOW); 
-    
-    // 2. Put data on bus and pulse Enable
-    DIO_Set_PORT_VALUE(GLCD_DATA_PORT, data);
-    DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_E_PIN, HIGH);
-    _delay_us(1); 
-    DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_E_PIN, LOW);
+#if !GLCD_QUEUE
+// Streams len bytes to the currently selected chip(s) from the current
+// column, relying on the controller's column auto-increment. Everything is
+// inlined: the busy poll still has to flip RS/RW for the status read (KS0108
+// protocol), but there are no calls or address commands between bytes.
+static void GLCD_BusStream(const uint8_t* buf, uint8_t len) {
+    while (len--) {
+        GLCD_WaitReady();
+        GLCD_BusWrite(1, *buf++);
+    }
+}
+#endif
+
+#if GLCD_STATS
+// Frame stats = bus counters now minus the ones at the start of the frame
+static void GLCD_Stats_Frame(const GLCD_Stats* start) {
+    GLCD_Frame_Stats.commands     = GLCD_Bus_Stats.commands     - start->commands;
+    GLCD_Frame_Stats.data_bytes   = GLCD_Bus_Stats.data_bytes   - start->data_bytes;
+    GLCD_Frame_Stats.strobes      = GLCD_Bus_Stats.strobes      - start->strobes;
+    GLCD_Frame_Stats.busy_polls   = GLCD_Bus_Stats.busy_polls   - start->busy_polls;
+    GLCD_Frame_Stats.chip_selects = GLCD_Bus_Stats.chip_selects - start->chip_selects;
+    GLCD_Frame_Stats.delay_us     = GLCD_Bus_Stats.delay_us     - start->delay_us;
+}
+#endif
+
+#if GLCD_QUEUE
+// --- Bus Queue ---
+// A byte ring of records, filled by the drawing side and sent by the Timer2
+// compare ISR. The first byte of a record says what it is:
+
+#define GLCD_Q_TYPE_MASK   0xC0
+#define GLCD_Q_DATA        0x00    // 0x01-0x3F: that many data bytes follow
+#define GLCD_Q_SELECT      0x40    // | chip (GLCD_CHIP_*)
+#define GLCD_Q_COMMAND     0x80    // the command byte follows
+#define GLCD_Q_FRAME       0xC0    // end of a GLCD_Flush()
+
+#define GLCD_Q_RUN_MAX     0x3F
+#define GLCD_Q_MASK        (GLCD_QUEUE_SIZE - 1)
+
+#if (GLCD_QUEUE_SIZE & GLCD_Q_MASK) != 0 || GLCD_QUEUE_SIZE > 256 || GLCD_QUEUE_SIZE < 32
+#error "GLCD_QUEUE_SIZE must be a power of 2 from 32 to 256"
+#endif
+
+static uint8_t GLCD_Queue[GLCD_QUEUE_SIZE];
+static volatile uint8_t GLCD_Queue_Head = 0;   // Next byte to send (ISR side)
+static volatile uint8_t GLCD_Queue_Tail = 0;   // Next free byte (drawing side)
+static uint8_t GLCD_Queue_Run = 0;             // Data bytes left in the record being sent
+
+// Non-blocking GLCD_WaitReady(): one status read per asserted chip. Returns
+// 1 with the bus in write mode, or 0 if a chip is still busy.
+static inline uint8_t GLCD_TryReady(void) {
+    uint8_t busy;
+
+    GLCD_StatusMode();
+    if (GLCD_SelectedChip == GLCD_CHIP_BOTH) {
+        // One chip at a time, as in GLCD_WaitReady()
+        DIO_FAST_PIN_LOW(GLCD_CONTROL_PORT_REG, GLCD_CS2_PIN);
+        busy = GLCD_StatusBusy();
+        DIO_FAST_PIN_LOW(GLCD_CONTROL_PORT_REG, GLCD_CS1_PIN);
+        DIO_FAST_PIN_HIGH(GLCD_CONTROL_PORT_REG, GLCD_CS2_PIN);
+        busy |= GLCD_StatusBusy();
+        DIO_FAST_PIN_HIGH(GLCD_CONTROL_PORT_REG, GLCD_CS1_PIN);
+    } else {
+        busy = GLCD_StatusBusy();
+    }
+    if (busy) {
+        return 0;
+    }
+    GLCD_WriteMode();
+    return 1;
+}
+
+// Sends up to GLCD_QUEUE_BURST bus writes. Stops early at a busy chip; its
+// byte stays at the head and goes out on the next call.
+static void GLCD_Queue_Service(void) {
+    uint8_t head = GLCD_Queue_Head;
+    uint8_t budget = GLCD_QUEUE_BURST;
+
+    while (budget != 0 && head != GLCD_Queue_Tail) {
+        uint8_t record = GLCD_Queue[head];
+        uint8_t type = (GLCD_Queue_Run != 0) ? GLCD_Q_DATA : (record & GLCD_Q_TYPE_MASK);
+
+        if (type == GLCD_Q_SELECT) {
+            GLCD_AssertChip(record & GLCD_CHIP_BOTH);
+        } else if (type == GLCD_Q_FRAME) {
+#if GLCD_STATS
+            GLCD_Stats_Frame(&GLCD_Frame_Start);
+            GLCD_Frame_Start = GLCD_Bus_Stats;
+#endif
+        } else if (type == GLCD_Q_DATA && GLCD_Queue_Run == 0) {
+            GLCD_Queue_Run = record;    // Header of a data run
+        } else {
+            // A command or data byte: needs the bus
+            if (!GLCD_TryReady()) {
+                break;
+            }
+            if (type == GLCD_Q_COMMAND) {
+                head = (head + 1) & GLCD_Q_MASK;
+                GLCD_BusWrite(0, GLCD_Queue[head]);
+            } else {
+                GLCD_BusWrite(1, record);
+                GLCD_Queue_Run--;
+            }
+            budget--;
+        }
+        head = (head + 1) & GLCD_Q_MASK;
+    }
+    GLCD_Queue_Head = head;
+}
+
+ISR(TIMER2_COMP_vect) {
+    GLCD_Queue_Service();
+    if (GLCD_Queue_Head == GLCD_Queue_Tail) {
+        // Nothing left: no more ticks until the next record
+        Timer2_INT_DISABLE(TIMER2_INT_OCF);
+    }
+}
+
+// Sends from the calling context while interrupts are off (GLCD_Init()
+// before sei(), or a caller inside ATOMIC_BLOCK), where the ISR cannot run
+static inline void GLCD_Queue_Poll(void) {
+    if (!(SREG & (1 << SREG_I))) {
+        GLCD_Queue_Service();
+    }
+}
+
+// Bytes that can be appended right now (one slot always stays empty)
+static inline uint8_t GLCD_Queue_Free(void) {
+    return GLCD_Q_MASK - ((GLCD_Queue_Tail - GLCD_Queue_Head) & GLCD_Q_MASK);
+}
+
+// Appends one record (type byte + len bytes). Never waits: the caller has
+// made sure it fits (GLCD_Out_Fit() / GLCD_Out_Room()).
+static void GLCD_Queue_Put(uint8_t record, const uint8_t* data, uint8_t len) {
+    uint8_t tail = GLCD_Queue_Tail;
+    GLCD_Queue[tail] = record;
+    tail = (tail + 1) & GLCD_Q_MASK;
+    while (len--) {
+        GLCD_Queue[tail] = *data++;
+        tail = (tail + 1) & GLCD_Q_MASK;
+    }
+
+    // Publish the whole record at once, the ISR never sees half of it
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        GLCD_Queue_Tail = tail;
+        Timer2_INT_ENABLE(TIMER2_INT_OCF);
+    }
+}
+
+// Timer2 in CTC mode as the queue tick; its interrupt is only on while
+// there is something to send
+static void GLCD_Queue_Start(void) {
+    init_Timer2(TIMER2_MODE_CTC, GLCD_QUEUE_TICK_CS);
+    Timer2_SET_COMP_VAL((char)GLCD_QUEUE_TICK_OCR);
+}
+#endif
+
+// Set while a GLCD_Flush() stopped at a full queue: the rest of that frame
+// is still dirty in the framebuffer
+static uint8_t GLCD_Flush_Stopped = 0;
+
+uint8_t GLCD_Flush_Pending(void) {
+    return GLCD_Flush_Stopped;
+}
+
+uint8_t GLCD_Frame_Complete(void) {
+#if GLCD_QUEUE
+    return !GLCD_Flush_Stopped && GLCD_Queue_Head == GLCD_Queue_Tail;
+#else
+    return 1;   // Every call has already waited for the panel
+#endif
+}
+
+// --- Bus Output ---
+// Everything the driver sends after reset goes through GLCD_Out_*, queued or
+// direct. They track the chip selection and the page/column address the
+// panel will have once all earlier output is sent, and drop selects and
+// address commands that would not change them. Data advances the column,
+// wrapping at 64 like the controller's address counter.
+
+#define GLCD_ADDR_UNKNOWN  0xFF
+
+static uint8_t GLCD_Out_Chip = 0;
+static uint8_t GLCD_Out_Page[2];
+static uint8_t GLCD_Out_Column[2];
+
+// Worst-case queue bytes of an address set-up: chip select, page and
+// column commands
+#define GLCD_OUT_SETUP_COST    5
+
+// 1 if bytes more queue bytes fit now (always, when writing directly)
+static uint8_t GLCD_Out_Room(uint8_t bytes) {
+#if GLCD_QUEUE
+    return GLCD_Queue_Free() >= bytes;
+#else
+    (void)bytes;
+    return 1;
+#endif
+}
+
+// How many of len (at most 64) data bytes fit now behind an address set-up
+static uint8_t GLCD_Out_Fit(uint8_t len) {
+#if GLCD_QUEUE
+    uint8_t free = GLCD_Queue_Free();
+
+    if (free <= GLCD_OUT_SETUP_COST + 1) {
+        return 0;
+    }
+    free -= GLCD_OUT_SETUP_COST;
+    // One run header, two once it is longer than GLCD_Q_RUN_MAX
+    free = (free > GLCD_Q_RUN_MAX + 1) ? free - 2 : free - 1;
+    return (len < free) ? len : free;
+#else
+    return len;
+#endif
+}
+
+static void GLCD_Out_Reset(void) {
+    GLCD_Out_Chip = 0;
+    GLCD_Out_Page[0] = GLCD_Out_Page[1] = GLCD_ADDR_UNKNOWN;
+    GLCD_Out_Column[0] = GLCD_Out_Column[1] = GLCD_ADDR_UNKNOWN;
+}
+
+static void GLCD_Out_Select(uint8_t chip) {
+    if (chip == GLCD_Out_Chip) {
+        return;
+    }
+    GLCD_Out_Chip = chip;
+#if GLCD_QUEUE
+    GLCD_Queue_Put(GLCD_Q_SELECT | chip, 0, 0);
+#else
+    GLCD_SelectChip(chip);
+#endif
+}
+
+static void GLCD_Out_Command(uint8_t cmd) {
+    uint8_t* addr = 0;
+    uint8_t value = 0;
+
+    if ((cmd & 0xF8) == GLCD_SET_PAGE_ADDR) {
+        addr = GLCD_Out_Page;
+        value = cmd & 0x07;
+    } else if ((cmd & 0xC0) == GLCD_SET_COLUMN_ADDR) {
+        addr = GLCD_Out_Column;
+        value = cmd & 0x3F;
+    }
+
+    if (addr != 0) {
+        // Skip it if every selected chip is already there
+        uint8_t same = (GLCD_Out_Chip != 0);
+        for (uint8_t i = 0; i < 2; i++) {
+            if (GLCD_Out_Chip & (1 << i)) {
+                same &= (addr[i] == value);
+                addr[i] = value;
+            }
+        }
+        if (same) {
+            return;
+        }
+    }
+
+#if GLCD_QUEUE
+    GLCD_Queue_Put(GLCD_Q_COMMAND, &cmd, 1);
+#else
+    GLCD_Command(cmd);
+#endif
+}
+
+static void GLCD_Out_Data(const uint8_t* buf, uint8_t len) {
+    for (uint8_t i = 0; i < 2; i++) {
+        if ((GLCD_Out_Chip & (1 << i)) && GLCD_Out_Column[i] != GLCD_ADDR_UNKNOWN) {
+            GLCD_Out_Column[i] = (GLCD_Out_Column[i] + len) & ((GLCD_WIDTH / 2) - 1);
+        }
+    }
+
+#if GLCD_QUEUE
+    while (len != 0) {
+        uint8_t run = len;
+        if (run > GLCD_Q_RUN_MAX) {
+            run = GLCD_Q_RUN_MAX;
+        }
+        GLCD_Queue_Put(GLCD_Q_DATA | run, buf, run);
+        buf += run;
+        len -= run;
+    }
+#else
+    GLCD_BusStream(buf, len);
+#endif
+}
+
+// Marks the end of a GLCD_Flush(): frame stats are taken there when queued
+static void GLCD_Out_Frame_End(void) {
+#if GLCD_QUEUE
+    GLCD_Queue_Put(GLCD_Q_FRAME, 0, 0);
+#endif
+}
+
+// --- Shadow Framebuffer ---
+// All drawing goes into this RAM copy of the panel (8 pages x 128 columns).
+// Every byte that actually changes gets its bit set in the dirty map, and
+// GLCD_Flush() sends only those column spans over the bus.
+
+static uint8_t GLCD_FrameBuffer[GLCD_PAGES][GLCD_WIDTH];
+static uint8_t GLCD_DirtyMap[GLCD_PAGES][GLCD_WIDTH / 8];
+
+// Software cursor used by GLCD_GoToPageColumn() / GLCD_Data()
+static uint8_t GLCD_CursorPage = 0;
+static uint8_t GLCD_CursorColumn = GLCD_WIDTH;
+
+// Display start line per chip: requested value and the one last sent.
+// The framebuffer stays in panel RAM order; the start line only changes which
+// RAM row appears at the top of each half.
+static uint8_t GLCD_StartLine[2] = {0, 0};
+static uint8_t GLCD_StartLineSent[2] = {0, 0};
+
+// Waveform behind GLCD_Draw_Signal, set up on first use and again after
+// GLCD_FillPages() has overwritten what it drew
+static Waveform GLCD_Signal;
+static uint8_t GLCD_Signal_Ready = 0;
+
+// Writes one byte into the framebuffer, marking it dirty only if it changed
+static void GLCD_FB_Write(uint8_t page, uint8_t column, uint8_t data) {
+    if (GLCD_FrameBuffer[page][column] != data) {
+        GLCD_FrameBuffer[page][column] = data;
+        GLCD_DirtyMap[page][column >> 3] |= (1 << (column & 7));
+    }
+}
+
+// Fills len columns of a page in the framebuffer with the same byte
+static void GLCD_FB_Fill(uint8_t page, uint8_t column, uint8_t data, uint8_t len) {
+    while (len-- && column < GLCD_WIDTH) {
+        GLCD_FB_Write(page, column++, data);
+    }
+}
+
+// Marks a framebuffer span clean after it was sent to the panel
+static void GLCD_FB_Clean(uint8_t page, uint8_t column, uint8_t len) {
+    while (len--) {
+        GLCD_DirtyMap[page][column >> 3] &= ~(1 << (column & 7));
+        column++;
+    }
+}
+
+// Marks a span dirty whatever it holds, so the next flush sends it
+static void GLCD_FB_Dirty(uint8_t page, uint8_t column, uint8_t len) {
+    while (len--) {
+        GLCD_DirtyMap[page][column >> 3] |= (1 << (column & 7));
+        column++;
+    }
 }
 
 // --- Public Driver Functions ---
 
 // Initializes GLCD control ports and sends initialization commands
 void GLCD_Init(void) {
-    // 1. Configure Control Pins (OUTPUT) - Use GLCD_CONTROL_PORT
-    DIO_Set_PIN_DIR(GLCD_CONTROL_PORT, GLCD_RS_PIN, OUTPUT);
-    DIO_Set_PIN_DIR(GLCD_CONTROL_PORT, GLCD_RW_PIN, OUTPUT);
-    DIO_Set_PIN_DIR(GLCD_CONTROL_PORT, GLCD_E_PIN, OUTPUT);
-    DIO_Set_PIN_DIR(GLCD_CONTROL_PORT, GLCD_CS1_PIN, OUTPUT);
-    DIO_Set_PIN_DIR(GLCD_CONTROL_PORT, GLCD_CS2_PIN, OUTPUT);
-    DIO_Set_PIN_DIR(GLCD_CONTROL_PORT, GLCD_RST_PIN, OUTPUT);
+    // 1. Configure Control Pins (OUTPUT)
+    DIO_FAST_PIN_OUTPUT(GLCD_CONTROL_DDR_REG, GLCD_RS_PIN);
+    DIO_FAST_PIN_OUTPUT(GLCD_CONTROL_DDR_REG, GLCD_RW_PIN);
+    DIO_FAST_PIN_OUTPUT(GLCD_CONTROL_DDR_REG, GLCD_E_PIN);
+    DIO_FAST_PIN_OUTPUT(GLCD_CONTROL_DDR_REG, GLCD_CS1_PIN);
+    DIO_FAST_PIN_OUTPUT(GLCD_CONTROL_DDR_REG, GLCD_CS2_PIN);
+    DIO_FAST_PIN_OUTPUT(GLCD_CONTROL_DDR_REG, GLCD_RST_PIN);
     
-    // 2. Configure Data Port (OUTPUT) - Use GLCD_DATA_PORT
-    DIO_Set_PORT_DIR(GLCD_DATA_PORT, 0xFF);
+    // 2. Configure Data Port (OUTPUT)
+    DIO_FAST_PORT_DIR(GLCD_DATA_DDR_REG, OUTPUT_PORT);
 
     // 3. Hardware Reset (briefly pull RST low)
-    DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_RST_PIN, LOW);
+    DIO_FAST_PIN_LOW(GLCD_CONTROL_PORT_REG, GLCD_RST_PIN);
     _delay_ms(10);
-    DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_RST_PIN, HIGH);
+    DIO_FAST_PIN_HIGH(GLCD_CONTROL_PORT_REG, GLCD_RST_PIN);
     _delay_ms(10);
+    GLCD_STAT_ADD(delay_us, 20000);
     
-    // 4. Send initialization commands to both chips
-    // Select Chip 1 (Left Half)
-    GLCD_SelectChip(1);
-    GLCD_Command(GLCD_DISPLAY_ON);
-    GLCD_Command(GLCD_START_LINE_ADDR + 0);
-    
-    // Select Chip 2 (Right Half)
-    GLCD_SelectChip(2);
-    GLCD_Command(GLCD_DISPLAY_ON);
-    GLCD_Command(GLCD_START_LINE_ADDR + 0);
+    // 4. Send initialization commands to both chips at once
+#if GLCD_QUEUE
+    GLCD_Queue_Start();
+#endif
+    GLCD_Out_Reset();
+    GLCD_Out_Select(GLCD_CHIP_BOTH);
+    GLCD_Out_Command(GLCD_DISPLAY_ON);
+    GLCD_Out_Command(GLCD_START_LINE_ADDR + 0);
+    GLCD_StartLine[0] = GLCD_StartLine[1] = 0;
+    GLCD_StartLineSent[0] = GLCD_StartLineSent[1] = 0;
     
-    // Clear the whole display
+    // Clear the whole display: the panel RAM is undefined after reset,
+    // so every byte is written instead of diffed
     GLCD_ClearScreen();
-}
-
-// Simple string reversal helper for int_to_string
-static void reverse(char s[]) {
-    uint8_t i, j;
-    char c;
-    for (i = 0, j = strlen(s) - 1; i < j; i++, j--) {
-        c = s[i];
-        s[i] = s[j];
-        s[j] = c;
+#if GLCD_QUEUE
+    // More than the queue holds: send it all before returning (interrupts
+    // are still off here, otherwise the ISR does the sending)
+    while (!GLCD_Flush()) {
+        GLCD_Queue_Poll();
+    }
+    while (GLCD_Queue_Head != GLCD_Queue_Tail) {
+        GLCD_Queue_Poll();
     }
+#else
+    GLCD_Flush();
+#endif
 }
 
 // Custom function to convert integer value to a string (itoa)
+// Kept for compatibility; Format.h has the fixed-width, division-free versions
 void int_to_string(int32_t value, char *buffer) {
-    uint8_t i = 0;
-    
-    // Handle 0
-    if (value == 0) {
-        buffer[i++] = '0';
-        buffer[i] = '\0';
-        return;
+    Format_Number32(buffer, (uint32_t)value, 0, FORMAT_SIGNED);
+}
+
+// Fills whole pages (both halves) with the same byte in the framebuffer.
+// Covers clears, page blanking and horizontal rules (e.g. pattern 0x01).
+// Every byte of those pages is marked dirty, changed or not, and goes out
+// with the next GLCD_Flush(), which broadcasts columns whose two halves are
+// equal to both chips at once, so each byte crosses the bus only once.
+void GLCD_FillPages(uint8_t first_page, uint8_t last_page, uint8_t pattern) {
+    if (last_page >= GLCD_PAGES) {
+        last_page = GLCD_PAGES - 1;
     }
-    
-    // Process digits in reverse order
-    while (value > 0) {
-        buffer[i++] = (value % 10) + '0';
-        value /= 10;
+
+    // Any waveform it drew is gone, the next GLCD_Draw_Signal starts over
+    GLCD_Signal_Ready = 0;
+
+    for (uint8_t page = first_page; page <= last_page; page++) {
+        memset(GLCD_FrameBuffer[page], pattern, GLCD_WIDTH);
+        GLCD_FB_Dirty(page, 0, GLCD_WIDTH);
     }
-    buffer[i] = '\0';
-    
-    reverse(buffer);
 }
 
 // Clears the entire GLCD screen (fills all memory with 0x00)
 void GLCD_ClearScreen(void) {
-    for (uint8_t page = 0; page < GLCD_PAGES; page++) {
-        // Clear Chip 1
-        GLCD_SelectChip(1);
-        GLCD_Command(GLCD_SET_PAGE_ADDR + page);
-        GLCD_Command(GLCD_SET_COLUMN_ADDR + 0);
+    GLCD_FillPages(0, GLCD_PAGES - 1, 0x00);
+}
+
+// Sends the spans of one page whose bits are set in mask (64 local columns).
+// chip is 1, 2, or GLCD_CHIP_BOTH to send columns whose two halves are equal.
+// Short gaps inside a span are re-sent instead of paying for a new address,
+// as long as re-sending them is harmless (always, for a single chip).
+// Returns 0 if the queue filled up: what was not sent stays dirty.
+#define GLCD_FLUSH_MERGE_GAP   2
+
+static uint8_t GLCD_Flush_Spans(uint8_t page, uint8_t chip, const uint8_t* mask) {
+    const uint8_t half = GLCD_WIDTH / 2;
+    uint8_t base = (chip == GLCD_CHIP_2) ? half : 0;
+    uint8_t *row = GLCD_FrameBuffer[page];
+    uint8_t col = 0;
+    uint8_t chip_selected = 0;
+
+    while (col < half) {
+        // Skip 8 clean columns at a time
+        if (mask[col >> 3] == 0) {
+            col = (col | 7) + 1;
+            continue;
+        }
+        if (!(mask[col >> 3] & (1 << (col & 7)))) {
+            col++;
+            continue;
+        }
+
+        // Find the end of the span (merging short gaps)
+        uint8_t start = col;
+        uint8_t end = col;
+        for (uint8_t c = col; c < half; c++) {
+            if (mask[c >> 3] & (1 << (c & 7))) {
+                end = c + 1;
+            } else if (c - end >= GLCD_FLUSH_MERGE_GAP
+                       || (chip == GLCD_CHIP_BOTH && row[c] != row[c + half])) {
+                break;
+            }
+        }
+
+        // Only the part that fits, the rest goes out on the next call
+        uint8_t len = GLCD_Out_Fit(end - start);
+        if (len == 0) {
+            return 0;
+        }
+
+        if (!chip_selected) {
+            GLCD_Out_Select(chip);
+            GLCD_Out_Command(GLCD_SET_PAGE_ADDR + page);
+            chip_selected = 1;
+        }
+        GLCD_Out_Command(GLCD_SET_COLUMN_ADDR + start);
+
+        GLCD_FB_Clean(page, base + start, len);
+        if (chip == GLCD_CHIP_BOTH) {
+            GLCD_FB_Clean(page, half + start, len);
+        }
+        GLCD_Out_Data(&row[base + start], len);
+        if (len != end - start) {
+            return 0;
+        }
+        col = end;
+    }
+    return 1;
+}
+
+// Order of the three passes of a page, starting with the chip selection
+// the previous page ended on: one chip switch fewer per page
+static const uint8_t GLCD_Flush_Order[4][3] = {
+    { GLCD_CHIP_BOTH, GLCD_CHIP_1, GLCD_CHIP_2 },   // Nothing selected yet
+    { GLCD_CHIP_1, GLCD_CHIP_2, GLCD_CHIP_BOTH },
+    { GLCD_CHIP_2, GLCD_CHIP_1, GLCD_CHIP_BOTH },
+    { GLCD_CHIP_BOTH, GLCD_CHIP_1, GLCD_CHIP_2 },
+};
+
+// Sends every dirty span of the framebuffer to the panel.
+// Columns that are dirty with identical bytes on both halves (e.g. the
+// waveform period repeated on each chip) are broadcast to both chips at once.
+// Stops where the queue is full; the next call picks up what is still dirty.
+uint8_t GLCD_Flush(void) {
+    const uint8_t half = GLCD_WIDTH / 2;
+#if GLCD_STATS && !GLCD_QUEUE
+    GLCD_Stats start = GLCD_Bus_Stats;
+#endif
 
-        for (uint8_t col = 0; col < (GLCD_WIDTH / 2); col++) {
-            GLCD_Data(0x00);
+    for (uint8_t page = 0; page < GLCD_PAGES; page++) {
+        uint8_t *dirty = GLCD_DirtyMap[page];
+        uint8_t *row = GLCD_FrameBuffer[page];
+        // Per pass: broadcast columns, then the rest of chip 1 and chip 2
+        uint8_t masks[3][GLCD_WIDTH / 16];
+        uint8_t any[3] = {0, 0, 0};
+
+        for (uint8_t i = 0; i < sizeof(masks[0]); i++) {
+            uint8_t both = dirty[i] & dirty[i + sizeof(masks[0])];
+            for (uint8_t bit = 0; both != 0 && bit < 8; bit++) {
+                uint8_t c = (i << 3) + bit;
+                if ((both & (1 << bit)) && row[c] != row[c + half]) {
+                    both &= ~(1 << bit);
+                }
+            }
+            masks[0][i] = both;
+            masks[1][i] = dirty[i] & ~both;
+            masks[2][i] = dirty[i + sizeof(masks[0])] & ~both;
+            any[0] |= masks[0][i];
+            any[1] |= masks[1][i];
+            any[2] |= masks[2][i];
         }
 
-        // Clear Chip 2
-        GLCD_SelectChip(2);
-        GLCD_Command(GLCD_SET_PAGE_ADDR + page);
-        GLCD_Command(GLCD_SET_COLUMN_ADDR + 0);
+        const uint8_t* order = GLCD_Flush_Order[GLCD_Out_Chip];
+        for (uint8_t pass = 0; pass < 3; pass++) {
+            uint8_t chip = order[pass];
+            uint8_t index = (chip == GLCD_CHIP_BOTH) ? 0 : chip;
+            if (any[index] && !GLCD_Flush_Spans(page, chip, masks[index])) {
+                GLCD_Flush_Stopped = 1;
+                return 0;
+            }
+        }
+    }
 
-        for (uint8_t col = 0; col < (GLCD_WIDTH / 2); col++) {
-            GLCD_Data(0x00);
+    // Scroll last, so newly written rows and the new start line appear together
+    for (uint8_t chip = GLCD_CHIP_1; chip <= GLCD_CHIP_2; chip++) {
+        if (GLCD_StartLine[chip - 1] != GLCD_StartLineSent[chip - 1]) {
+            if (!GLCD_Out_Room(3)) {
+                GLCD_Flush_Stopped = 1;
+                return 0;
+            }
+            GLCD_Out_Select(chip);
+            GLCD_Out_Command(GLCD_START_LINE_ADDR + GLCD_StartLine[chip - 1]);
+            GLCD_StartLineSent[chip - 1] = GLCD_StartLine[chip - 1];
         }
     }
+
+    if (!GLCD_Out_Room(1)) {
+        GLCD_Flush_Stopped = 1;
+        return 0;
+    }
+    GLCD_Out_Frame_End();
+    GLCD_Flush_Stopped = 0;
+#if GLCD_STATS && !GLCD_QUEUE
+    GLCD_Stats_Frame(&start);
+#endif
+    return 1;
+}
+
+// Copies len bytes into the framebuffer at page/column (clipped at the right
+// edge) and marks them all dirty, changed or not, so the next GLCD_Flush()
+// rewrites them on the panel whatever it held.
+void GLCD_DataBurst(uint8_t page, uint8_t column, const uint8_t* buf, uint8_t len) {
+    if (page >= GLCD_PAGES || column >= GLCD_WIDTH) {
+        return; // Ignore invalid coordinates
+    }
+    if (len > GLCD_WIDTH - column) {
+        len = GLCD_WIDTH - column; // Clip at the right edge
+    }
+
+    memmove(&GLCD_FrameBuffer[page][column], buf, len);
+    GLCD_FB_Dirty(page, column, len);
 }
 
 // *** CRUCIAL CURSOR-SETTING FUNCTION (GoToPageColumn) ***
-// This function translates the 128-column address into a chip select and local column address.
+// Sets the framebuffer cursor used by GLCD_Data(). The chip select and
+// local column address are worked out by GLCD_Flush() when the data is sent.
 void GLCD_GoToPageColumn(uint8_t page, uint8_t column) {
     if (page >= GLCD_PAGES || column >= GLCD_WIDTH) {
         return; // Ignore invalid coordinates
     }
 
-    uint8_t chip;
-    uint8_t local_column;
+    GLCD_CursorPage = page;
+    GLCD_CursorColumn = column;
+}
 
-    // 1. Determine which chip to address (Left or Right)
-    if (column < (GLCD_WIDTH / 2)) {
-        // Column 0-63 (Left Chip)
-        chip = 1;
-        local_column = column;
-    } else {
-        // Column 64-127 (Right Chip)
-        chip = 2;
-        // Local column is relative to the chip (e.g., global 64 is local 0)
-        local_column = column - (GLCD_WIDTH / 2);
+// Sets the hardware start line (0-63) of one chip or both: RAM row `line`
+// becomes the top row of that half. Sent by the next GLCD_Flush().
+void GLCD_SetStartLine(uint8_t chip, uint8_t line) {
+    line &= (GLCD_HEIGHT - 1);
+    if (chip == GLCD_CHIP_1 || chip == GLCD_CHIP_BOTH) {
+        GLCD_StartLine[0] = line;
     }
-    
-    // 2. Select the determined chip
-    GLCD_SelectChip(chip);
+    if (chip == GLCD_CHIP_2 || chip == GLCD_CHIP_BOTH) {
+        GLCD_StartLine[1] = line;
+    }
+}
 
-    // 3. Send the address commands to the chip
-    GLCD_Command(GLCD_SET_PAGE_ADDR + page);
-    GLCD_Command(GLCD_SET_COLUMN_ADDR + local_column);
+uint8_t GLCD_GetStartLine(uint8_t chip) {
+    return (chip == GLCD_CHIP_2) ? GLCD_StartLine[1] : GLCD_StartLine[0];
 }
 
-// Writes a single character at the specified starting position
-void GLCD_WriteChar(uint8_t page, uint8_t column, char ch) {
-    
+// Reads back one framebuffer byte (8 vertical pixels), for read-modify-write
+uint8_t GLCD_ReadByte(uint8_t page, uint8_t column) {
+    if (page >= GLCD_PAGES || column >= GLCD_WIDTH) {
+        return 0;
+    }
+    return GLCD_FrameBuffer[page][column];
+}
+
+// Writes one framebuffer byte without moving the GLCD_Data() cursor
+void GLCD_WriteByte(uint8_t page, uint8_t column, uint8_t data) {
+    if (page >= GLCD_PAGES || column >= GLCD_WIDTH) {
+        return;
+    }
+    GLCD_FB_Write(page, column, data);
+}
+
+// Writes a data byte (pixels) at the cursor and advances it one column.
+// Bytes past the right edge of the display are dropped.
+void GLCD_Data(uint8_t data) {
+    if (GLCD_CursorColumn >= GLCD_WIDTH) {
+        return;
+    }
+    GLCD_FB_Write(GLCD_CursorPage, GLCD_CursorColumn, data);
+    GLCD_CursorColumn++;
+}
+
+// Copies one 6-column character cell (5 glyph columns + 1 blank) into the
+// framebuffer row, clipped at the right edge
+static void GLCD_FB_WriteChar(uint8_t page, uint8_t column, char ch) {
     // Check if character is in the defined font range
     uint8_t font_index = ch - FONT_START_CHAR;
     if (ch < FONT_START_CHAR || ch > FONT_END_CHAR) {
         font_index = 0; // Default to space if character is undefined
     }
 
-    // Go to the specified starting position
-    GLCD_GoToPageColumn(page, column);
-
-    // Draw the 5 columns of the character data
-    for (uint8_t i = 0; i < FONT_WIDTH; i++) {
-        GLCD_Data(FONT_DATA[font_index][i]);
+    // Draw the 5 columns of the character data (fetched from flash)
+    uint8_t glyph[FONT_WIDTH];
+    Font_Read_Glyph(font_index, glyph);
+    for (uint8_t i = 0; i < FONT_WIDTH && column < GLCD_WIDTH; i++) {
+        GLCD_FB_Write(page, column++, glyph[i]);
     }
 
     // Draw one blank column for spacing
-    GLCD_Data(0x00);
+    if (column < GLCD_WIDTH) {
+        GLCD_FB_Write(page, column, 0x00);
+    }
+}
+
+// Writes a single character at the specified starting position
+void GLCD_WriteChar(uint8_t page, uint8_t column, char ch) {
+    if (page >= GLCD_PAGES || column >= GLCD_WIDTH) {
+        return; // Ignore invalid coordinates
+    }
+    GLCD_FB_WriteChar(page, column, ch);
 }
 
-// Writes a string starting at the specified page and column
+// Writes a string starting at the specified page and column.
+// The glyph columns go into the framebuffer row as one run; the flush then
+// streams it with a single address setup per chip. A character straddling
+// column 64 is simply split between the chips, so the text has no gap there.
 void GLCD_WriteString(uint8_t page, uint8_t column, const char* str) {
     uint8_t current_col = column;
 
-    for (uint8_t i = 0; i < strlen(str); i++) {
-        if (current_col > (GLCD_WIDTH / 2) - (FONT_WIDTH + 1)) {
-            // If the character cannot fit on the current chip (Chip 1 ends at 63),
-            // move the cursor to the start of the next chip (column 64).
-            if (current_col < (GLCD_WIDTH / 2)) {
-                current_col = GLCD_WIDTH / 2; // Sets it to 64
-            }
-        }
-    
-        GLCD_WriteChar(page, current_col, str[i]);
+    if (page >= GLCD_PAGES) {
+        return;
+    }
+
+    for (; *str != '\0'; str++) {
+        GLCD_FB_WriteChar(page, current_col, *str);
 
         // Characters are 5 pixels + 1 space = 6 pixels wide
         current_col += (FONT_WIDTH + 1); 
@@ -254,71 +842,55 @@ void GLCD_WriteString(uint8_t page, uint8_t column, const char* str) {
 }
 
 void GLCD_Write_Per(const char* str) {
-    // Clear the part of the percentage 
-        GLCD_GoToPageColumn(0, 100);
-        for (uint8_t i = 0; i < 100; i++) {
-            GLCD_Data(0x00);
-        }
-        GLCD_WriteString(0, 100, str);
+    // Text first, then blank only what is left of a longer old text: a byte
+    // cleared and redrawn with the same glyph would be dirty and sent again
+    uint16_t end = 100 + strlen(str) * (FONT_WIDTH + 1);
+
+    GLCD_WriteString(0, 100, str);
+    if (end < GLCD_WIDTH) {
+        GLCD_FB_Fill(0, (uint8_t)end, 0x00, GLCD_WIDTH - (uint8_t)end);
+    }
 }
 
+// Draws one period of the PWM signal on each chip half (pages 5-6):
+// high (top of page 5) for Signal_High columns, falling edge, low (bottom of
+// page 6), and a rising edge at column 63. Only changed columns are redrawn.
 void GLCD_Draw_Signal(char Signal_High) {
-    GLCD_GoToPageColumn(5,0);
-    for (uint8_t i = 0; i < Signal_High; i++) {
-        GLCD_Data(High);
-    }
-    if (Signal_High < 64) {
-        if (Signal_High != 0) {
-            GLCD_GoToPageColumn(5,63);
-            GLCD_Data(0xFF);
-            GLCD_GoToPageColumn(6,63);
-            GLCD_Data(0xFF);
-            GLCD_GoToPageColumn(5,(Signal_High));
-            GLCD_Data(0xFF);
-            GLCD_GoToPageColumn(6,(Signal_High));
-            GLCD_Data(0xFF);
-            for (uint8_t i = 0; i < (64 - Signal_High - 2); i++) {
-                GLCD_Data(Low);
-            }
-        }
-        else {
-            for (uint8_t i = 0; i < (64 - Signal_High); i++) {
-                GLCD_Data(Low);
-            }
-        }      
-    }
-    GLCD_GoToPageColumn(5,64);
-    for (uint8_t i = 0; i < Signal_High; i++) {
-        GLCD_Data(High);
-    }
-    if (Signal_High < 64) {
-        if (Signal_High != 0) {
-            GLCD_GoToPageColumn(5, (64 + Signal_High));
-            GLCD_Data(0xFF);
-            GLCD_GoToPageColumn(6,(64 + Signal_High));
-            GLCD_Data(0xFF);
-            for (uint8_t i = 0; i < (64 - Signal_High - 2); i++) {
-                GLCD_Data(Low);
-            }
-        }
-        else {
-            for (uint8_t i = 0; i < (64 - Signal_High - 2); i++) {
-                GLCD_Data(Low);
-            }
-        }   
-    }
-        
-    _delay_ms(100);
-        
-    //clear the part of the signal
-    for(uint8_t p = 5; p < 7; p++) {
-        GLCD_GoToPageColumn(p, 0);
-        for (uint8_t i = 0; i < 64; i++) {
-            GLCD_Data(0x00);
-        }
-        GLCD_GoToPageColumn(p, 64);
-        for (uint8_t i = 0; i < 64; i++) {
-            GLCD_Data(0x00);
-        }
-    }    
+    if (!GLCD_Signal_Ready) {
+        Waveform_Init(&GLCD_Signal, 5, 6, 0, GLCD_WIDTH, 2, 0, 0);
+        GLCD_Signal_Ready = 1;
+    }
+    Waveform_Draw(&GLCD_Signal, (uint8_t)Signal_High);
+}
+
+#if GLCD_STATS
+// Copies the bus counters; take one before and after any call to cost it
+// (atomic: with GLCD_QUEUE the ISR updates them)
+void GLCD_Get_Stats(GLCD_Stats* stats) {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        *stats = GLCD_Bus_Stats;
+    }
+}
+
+void GLCD_Reset_Stats(void) {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        memset(&GLCD_Bus_Stats, 0, sizeof(GLCD_Bus_Stats));
+#if GLCD_QUEUE
+        memset(&GLCD_Frame_Start, 0, sizeof(GLCD_Frame_Start));
+#endif
+    }
+}
+
+// Bus cost of the most recent GLCD_Flush(), i.e. of one displayed frame
+void GLCD_Get_Frame_Stats(GLCD_Stats* stats) {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        *stats = GLCD_Frame_Stats;
+    }
+}
+
+// Bus time of a set of counters: every strobe is at least one E cycle
+// (GLCD_E_CYCLE_NS, KS0108 minimum) on top of the requested delays
+uint32_t GLCD_Stats_Bus_Time_us(const GLCD_Stats* stats) {
+    return stats->delay_us + (stats->strobes * GLCD_E_CYCLE_NS) / 1000;
 }
+#endif
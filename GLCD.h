@@ -18,6 +18,13 @@
 #define GLCD_DATA_PORT         &PORTC
 #define GLCD_DATA_PORT_DIR     &DDRC
 
+// Same ports as plain register names, for the compile-time DIO_FAST_* macros
+#define GLCD_CONTROL_PORT_REG  PORTA
+#define GLCD_CONTROL_DDR_REG   DDRA
+#define GLCD_DATA_PORT_REG     PORTC
+#define GLCD_DATA_DDR_REG      DDRC
+#define GLCD_DATA_PIN_REG      PINC
+
 #define GLCD_RS_PIN            PA0 // Register Select (Command/Data)
 #define GLCD_RW_PIN            PA1 // Read/Write (Read=HIGH, Write=LOW)
 #define GLCD_E_PIN             PA2 // Enable (Pulse HIGH to execute)
@@ -26,6 +33,12 @@
 #define GLCD_RST_PIN           PA5 // Reset (Active LOW)
 
 
+// Chip select values for GLCD_SelectChip()
+#define GLCD_CHIP_1            1   // Left half
+#define GLCD_CHIP_2            2   // Right half
+#define GLCD_CHIP_BOTH         3   // Broadcast: CS1 and CS2 asserted together
+
+
 // --- GLCD Display Dimensions ---
 
 #define GLCD_WIDTH             128 // 128 columns (pixels)
@@ -52,23 +65,98 @@
 #define Low 0x80
 
 
+// --- Bus Statistics ---
+// Set GLCD_STATS to 1 (here or with -DGLCD_STATS=1) to count bus activity.
+// Each counter is a running total, so diff two snapshots to cost one call.
+#ifndef GLCD_STATS
+#define GLCD_STATS  0
+#endif
+
+typedef struct {
+    uint32_t commands;      // Command bytes written
+    uint32_t data_bytes;    // Data bytes written
+    uint32_t strobes;       // E pulses (writes + status reads)
+    uint32_t busy_polls;    // Status reads while waiting for the busy flag
+    uint32_t chip_selects;  // GLCD_SelectChip() calls
+    uint32_t delay_us;      // Microseconds requested from _delay_us/_delay_ms
+} GLCD_Stats;
+
+// Minimum enable cycle time of the KS0108 (tcyc), used for bus time estimates
+#define GLCD_E_CYCLE_NS        1000
+
+// --- Bus Queue ---
+// With GLCD_QUEUE = 1 nothing waits on the panel: GLCD_Flush() only
+// appends chip selects, commands and data to a ring, and the Timer2 compare
+// ISR sends up to GLCD_QUEUE_BURST bytes per tick. A chip that is still
+// busy is not polled in a loop, its byte simply waits for the next tick.
+// Address commands that would not change the panel's page/column are
+// dropped when queued.
+// Nothing waits for room in the ring either: what does not fit stays dirty
+// in the framebuffer and is sent by a later GLCD_Flush().
+// GLCD_QUEUE = 0 writes to the bus directly (and waits) as before.
+#ifndef GLCD_QUEUE
+#define GLCD_QUEUE             1
+#endif
+
+#define GLCD_QUEUE_SIZE        64  // Bytes, power of 2 (a full frame need not fit)
+#define GLCD_QUEUE_BURST       8   // Bus writes per tick
+// Tick: 16 MHz / 8 / (GLCD_QUEUE_TICK_OCR + 1) = 128 us. Up to 8 writes
+// (~4 us each) per tick keep the ISR below ~25% of the CPU while a frame
+// is being sent, and an idle queue costs nothing (the interrupt is off).
+#define GLCD_QUEUE_TICK_CS     TIMER2_CS_PRE_8
+#define GLCD_QUEUE_TICK_OCR    255
+
+
 // --- Public Function Prototypes ---
 
 void GLCD_Init(void);
 void GLCD_ClearScreen(void);
+// Fills pages first..last across the full width with one byte (clears, page
+// blanking, horizontal rules); the next GLCD_Flush() writes both chips at once
+void GLCD_FillPages(uint8_t first_page, uint8_t last_page, uint8_t pattern);
 
 // Data write function, used internally and needed for clearing artifacts
+// Writes into the shadow framebuffer at the cursor; call GLCD_Flush() to show it
 void GLCD_Data(uint8_t data);
 
 // *** The new cursor setting function ***
 // Sets the address pointer (page 0-7, column 0-127) for subsequent operations
 void GLCD_GoToPageColumn(uint8_t page, uint8_t column);
 
+// Sends the changed parts of the shadow framebuffer to the panel. Queued
+// with GLCD_QUEUE: returns 1 once the whole frame is in the queue, or 0 if
+// the queue filled up first. The rest stays dirty; call it again later (e.g.
+// on the next tick) to continue, drawing in between is fine.
+uint8_t GLCD_Flush(void);
+// 1 while a GLCD_Flush() has stopped part way through its frame
+uint8_t GLCD_Flush_Pending(void);
+// 1 once no flush is pending and everything queued so far is on the panel
+uint8_t GLCD_Frame_Complete(void);
+
+// Direct framebuffer byte access (page 0-7, column 0-127), no cursor involved
+uint8_t GLCD_ReadByte(uint8_t page, uint8_t column);
+void GLCD_WriteByte(uint8_t page, uint8_t column, uint8_t data);
+
+// Hardware vertical scroll: RAM row `line` (0-63) is shown at the top of the
+// chip's half (GLCD_CHIP_1, GLCD_CHIP_2 or GLCD_CHIP_BOTH). Applied on flush.
+void GLCD_SetStartLine(uint8_t chip, uint8_t line);
+uint8_t GLCD_GetStartLine(uint8_t chip);
+
+// Copies len bytes into the framebuffer from page/column and marks them
+// dirty even where they did not change: the next GLCD_Flush() rewrites them.
+void GLCD_DataBurst(uint8_t page, uint8_t column, const uint8_t* buf, uint8_t len);
+
 void GLCD_WriteChar(uint8_t page, uint8_t column, char ch);
 void GLCD_WriteString(uint8_t page, uint8_t column, const char* str);
 
 void int_to_string(int32_t value, char *buffer);
-static void reverse(char s[]);
+
+#if GLCD_STATS
+void GLCD_Get_Stats(GLCD_Stats* stats);
+void GLCD_Reset_Stats(void);
+void GLCD_Get_Frame_Stats(GLCD_Stats* stats);
+uint32_t GLCD_Stats_Bus_Time_us(const GLCD_Stats* stats);
+#endif
 
 void GLCD_Write_Per(const char* str);
 void GLCD_Draw_Signal(char Signal_High);
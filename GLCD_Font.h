@@ -12,6 +12,13 @@ Each character is 5 pixels wide and 8 pixels high (1 byte per column).
 
 #include <stdint.h>
 
+#if defined(__AVR__)
+#include <avr/pgmspace.h>
+#else
+#include <string.h>
+#define PROGMEM   // Host builds: the font is an ordinary const array
+#endif
+
 // Width of a single character in columns (pixels)
 #define FONT_WIDTH  5
 
@@ -22,7 +29,9 @@ Each character is 5 pixels wide and 8 pixels high (1 byte per column).
 
 // Character Data: Stored as 5 bytes (columns) per character.
 // The array includes pixel data for common symbols, digits, and the full alphabet.
-const uint8_t FONT_DATA[][FONT_WIDTH] = {
+// Kept in flash (PROGMEM) so its ~475 bytes do not take SRAM; read it with
+// Font_Read_Glyph(), never by indexing FONT_DATA directly.
+const uint8_t FONT_DATA[][FONT_WIDTH] PROGMEM = {
 // Space (0x20)
 { 0x00,0x00,0x00,0x00,0x00 },
 // ! (0x21)
@@ -215,4 +224,19 @@ const uint8_t FONT_DATA[][FONT_WIDTH] = {
 {0x00, 0x04, 0x02, 0x04, 0x02}, 
 };
 
+// Copies the FONT_WIDTH column bytes of one glyph (index = ch - FONT_START_CHAR)
+// out of flash, using lpm with Z post-increment for each byte
+static inline void Font_Read_Glyph(uint8_t font_index, uint8_t* columns) {
+#if defined(__AVR__)
+    const uint8_t* p = FONT_DATA[font_index];
+    for (uint8_t i = 0; i < FONT_WIDTH; i++) {
+        uint8_t b;
+        __asm__ ("lpm %0, Z+" : "=r" (b), "+z" (p));
+        columns[i] = b;
+    }
+#else
+    memcpy(columns, FONT_DATA[font_index], FONT_WIDTH);
+#endif
+}
+
 #endif // GLCD_FONT_H
\ No newline at end of file
@@ -0,0 +1,176 @@
+/*
+ * File:   Graphics.c
+ * Author: Mostafa Eshra
+ */
+
+#include "Graphics.h"
+#include "GLCD.h"
+
+// Applies color to the mask bits of one framebuffer byte. A full mask with
+// SET/CLEAR is a plain write, everything else a read-modify-write.
+static void Gfx_Merge(uint8_t page, uint8_t column, uint8_t mask, uint8_t color) {
+    if (mask == 0) {
+        return;
+    }
+    if (mask == 0xFF && color != GFX_INVERT) {
+        GLCD_WriteByte(page, column, (color == GFX_SET) ? 0xFF : 0x00);
+        return;
+    }
+
+    uint8_t data = GLCD_ReadByte(page, column);
+    if (color == GFX_SET) {
+        data |= mask;
+    } else if (color == GFX_CLEAR) {
+        data &= ~mask;
+    } else {
+        data ^= mask;
+    }
+    GLCD_WriteByte(page, column, data);
+}
+
+void Gfx_Pixel(uint8_t x, uint8_t y, uint8_t color) {
+    if (x >= GLCD_WIDTH || y >= GLCD_HEIGHT) {
+        return;
+    }
+    Gfx_Merge(y >> 3, x, (uint8_t)(1 << (y & 7)), color);
+}
+
+// Rows y0..y1 of columns x0..x1 (inclusive, already clipped), page by page:
+// the top and bottom pages get a partial mask, the ones between are whole
+static void Gfx_Fill_Span(uint8_t x0, uint8_t x1, uint8_t y0, uint8_t y1, uint8_t color) {
+    uint8_t first_page = y0 >> 3;
+    uint8_t last_page = y1 >> 3;
+
+    for (uint8_t page = first_page; page <= last_page; page++) {
+        uint8_t mask = 0xFF;
+        if (page == first_page) {
+            mask &= (uint8_t)(0xFF << (y0 & 7));
+        }
+        if (page == last_page) {
+            mask &= (uint8_t)(0xFF >> (7 - (y1 & 7)));
+        }
+        for (uint8_t x = x0; x <= x1; x++) {
+            Gfx_Merge(page, x, mask, color);
+        }
+    }
+}
+
+void Gfx_Fill_Rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t color) {
+    if (x >= GLCD_WIDTH || y >= GLCD_HEIGHT || width == 0 || height == 0) {
+        return;
+    }
+    uint16_t x1 = (uint16_t)x + width - 1;
+    uint16_t y1 = (uint16_t)y + height - 1;
+    if (x1 >= GLCD_WIDTH) {
+        x1 = GLCD_WIDTH - 1;
+    }
+    if (y1 >= GLCD_HEIGHT) {
+        y1 = GLCD_HEIGHT - 1;
+    }
+    Gfx_Fill_Span(x, (uint8_t)x1, y, (uint8_t)y1, color);
+}
+
+// One mask per column: a single byte write per page
+void Gfx_HLine(uint8_t x, uint8_t y, uint8_t width, uint8_t color) {
+    Gfx_Fill_Rect(x, y, width, 1, color);
+}
+
+// Whole bytes for the pages it covers completely, not 8 pixel operations
+void Gfx_VLine(uint8_t x, uint8_t y, uint8_t height, uint8_t color) {
+    Gfx_Fill_Rect(x, y, 1, height, color);
+}
+
+void Gfx_Rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t color) {
+    uint16_t right = (uint16_t)x + width - 1;
+    uint16_t bottom = (uint16_t)y + height - 1;
+
+    if (width == 0 || height == 0) {
+        return;
+    }
+    Gfx_HLine(x, y, width, color);
+    if (height > 1 && bottom < GLCD_HEIGHT) {
+        Gfx_HLine(x, (uint8_t)bottom, width, color);
+    }
+    // Sides without the corners, so GFX_INVERT does not flip them twice
+    if (height > 2) {
+        Gfx_VLine(x, y + 1, height - 2, color);
+        if (width > 1 && right < GLCD_WIDTH) {
+            Gfx_VLine((uint8_t)right, y + 1, height - 2, color);
+        }
+    }
+}
+
+void Gfx_Line(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t color) {
+    if (y0 == y1) {
+        Gfx_HLine((x0 < x1) ? x0 : x1, y0, ((x0 < x1) ? x1 - x0 : x0 - x1) + 1, color);
+        return;
+    }
+    if (x0 == x1) {
+        Gfx_VLine(x0, (y0 < y1) ? y0 : y1, ((y0 < y1) ? y1 - y0 : y0 - y1) + 1, color);
+        return;
+    }
+
+    // Bresenham, integer error term
+    int16_t dx = (x1 > x0) ? (x1 - x0) : (x0 - x1);
+    int16_t dy = (y1 > y0) ? (y0 - y1) : (y1 - y0);    // -|dy|
+    int8_t sx = (x0 < x1) ? 1 : -1;
+    int8_t sy = (y0 < y1) ? 1 : -1;
+    int16_t err = dx + dy;
+
+    for (;;) {
+        Gfx_Pixel(x0, y0, color);
+        if (x0 == x1 && y0 == y1) {
+            break;
+        }
+        int16_t e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+void Gfx_Bitmap(uint8_t x, uint8_t y, const uint8_t* bitmap, uint8_t width, uint8_t height, uint8_t color) {
+    uint8_t rows = (height + 7) >> 3;
+    uint8_t shift = y & 7;
+
+    if (x >= GLCD_WIDTH) {
+        return;
+    }
+
+    for (uint8_t row = 0; row < rows; row++) {
+        uint8_t page = (y >> 3) + row;
+        if (page >= GLCD_PAGES) {
+            return;
+        }
+
+        // The last row may be only partly inside the bitmap
+        uint8_t keep = 0xFF;
+        if (row == rows - 1 && (height & 7) != 0) {
+            keep = (uint8_t)(0xFF >> (8 - (height & 7)));
+        }
+
+        const uint8_t* src = &bitmap[(uint16_t)row * width];
+        for (uint8_t c = 0; c < width; c++) {
+            uint8_t column = x + c;
+            if (column >= GLCD_WIDTH) {
+                break;
+            }
+            uint8_t bits = src[c] & keep;
+            if (shift == 0) {
+                // Aligned: one merge per byte
+                Gfx_Merge(page, column, bits, color);
+            } else {
+                // Unaligned: low part into this page, high part into the next
+                Gfx_Merge(page, column, (uint8_t)(bits << shift), color);
+                if (page + 1 < GLCD_PAGES) {
+                    Gfx_Merge(page + 1, column, (uint8_t)(bits >> (8 - shift)), color);
+                }
+            }
+        }
+    }
+}
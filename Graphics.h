@@ -0,0 +1,37 @@
+/*
+ * File:   Graphics.h
+ * Author: Mostafa Eshra
+ *
+ * Description: Drawing primitives on the GLCD framebuffer, written for its
+ *              page/column layout (1 byte = 8 vertical pixels). Whole pages
+ *              are written as bytes without reading them back; only the
+ *              partial top and bottom pages are merged with a mask.
+ *
+ * x = 0..127 (column), y = 0..63 (row, y / 8 = page). Everything is clipped
+ * to the display. Drawing goes to the framebuffer, GLCD_Flush() shows it.
+ */
+
+#ifndef GRAPHICS_H
+#define	GRAPHICS_H
+
+#include <stdint.h>
+
+// Pixel colors
+#define GFX_CLEAR      0
+#define GFX_SET        1
+#define GFX_INVERT     2
+
+void Gfx_Pixel(uint8_t x, uint8_t y, uint8_t color);
+void Gfx_HLine(uint8_t x, uint8_t y, uint8_t width, uint8_t color);
+void Gfx_VLine(uint8_t x, uint8_t y, uint8_t height, uint8_t color);
+void Gfx_Rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t color);
+void Gfx_Fill_Rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t color);
+// Bresenham, horizontal and vertical lines take the fast paths above
+void Gfx_Line(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t color);
+// 1-bpp bitmap in the display layout: ceil(height / 8) rows of width column
+// bytes, LSB on top (same as the font). Set bits are drawn with color, clear
+// bits leave the screen as it is. Any y: unaligned rows are shifted and
+// merged into the two pages they straddle.
+void Gfx_Bitmap(uint8_t x, uint8_t y, const uint8_t* bitmap, uint8_t width, uint8_t height, uint8_t color);
+
+#endif	/* GRAPHICS_H */
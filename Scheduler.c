@@ -0,0 +1,118 @@
+/* 
+ * File:   Scheduler.c
+ * Author: Mostafa Eshra
+ */
+
+#include <avr/io.h>
+#include "Scheduler.h"
+#include "Timer.h"
+
+typedef struct {
+    Scheduler_Task_Fn task;
+    uint16_t period;
+    uint16_t deadline;
+    uint16_t release;       // Tick of the next release
+    uint16_t run_at;        // Tick it may run: the release, or after a retry
+    uint16_t wcet;          // Worst-case run time (timer counts)
+    uint16_t missed;        // Missed deadlines
+} Scheduler_Task;
+
+static Scheduler_Task Scheduler_Tasks[SCHEDULER_MAX_TASKS];
+static uint8_t Scheduler_Task_Count = 0;
+static uint8_t Scheduler_Retry_Requested = 0;
+
+void Scheduler_Init(void){
+    Scheduler_Task_Count = 0;
+    // Timer0 must already be running (init_Timer0), its overflow is the tick
+    Timer0_INT_ENABLE(TIMER0_INT_TOV);
+}
+
+uint8_t Scheduler_Add_Task(Scheduler_Task_Fn task, uint16_t period, uint16_t deadline){
+    if (Scheduler_Task_Count >= SCHEDULER_MAX_TASKS || period == 0) {
+        return SCHEDULER_INVALID_TASK;
+    }
+
+    Scheduler_Task* t = &Scheduler_Tasks[Scheduler_Task_Count];
+    t->task = task;
+    t->period = period;
+    t->deadline = deadline;
+    t->release = Timer0_Get_Ticks();
+    t->run_at = t->release;
+    t->wcet = 0;
+    t->missed = 0;
+
+    return Scheduler_Task_Count++;
+}
+
+void Scheduler_Run(void){
+    uint16_t now = Timer0_Get_Ticks();
+
+    for (uint8_t i = 0; i < Scheduler_Task_Count; i++) {
+        Scheduler_Task* t = &Scheduler_Tasks[i];
+
+        if ((int16_t)(now - t->run_at) < 0) {
+            continue; // Not released yet
+        }
+
+        // 1. Run the task and measure it
+        uint32_t start = Timer0_Get_Timestamp();
+        Scheduler_Retry_Requested = 0;
+        t->task();
+        uint32_t end = Timer0_Get_Timestamp();
+
+        uint32_t run_time = (end - start) & 0x00FFFFFFUL; // Timestamps are 24-bit
+        if (run_time > 0xFFFF) {
+            run_time = 0xFFFF;
+        }
+        if (run_time > t->wcet) {
+            t->wcet = (uint16_t)run_time;
+        }
+
+        // 2. Deadline check (in ticks, from the release time)
+        uint16_t finished = (uint16_t)(end >> 8);
+        if (Scheduler_Retry_Requested) {
+            // Not done with this release yet, back on the next tick
+            t->run_at = finished + 1;
+            return;
+        }
+        if ((uint16_t)(finished - t->release) > t->deadline) {
+            t->missed++;
+        }
+
+        // 3. Next release; releases that already passed are skipped and counted
+        t->release += t->period;
+        while ((int16_t)(finished - (uint16_t)(t->release + t->period)) >= 0) {
+            t->release += t->period;
+            t->missed++;
+        }
+        t->run_at = t->release;
+
+        // Only one task per pass so higher priority tasks get checked first again
+        return;
+    }
+}
+
+void Scheduler_Retry(void){
+    Scheduler_Retry_Requested = 1;
+}
+
+uint16_t Scheduler_Get_WCET(uint8_t task_id){
+    if (task_id >= Scheduler_Task_Count) {
+        return 0;
+    }
+    return Scheduler_Tasks[task_id].wcet;
+}
+
+uint16_t Scheduler_Get_Missed(uint8_t task_id){
+    if (task_id >= Scheduler_Task_Count) {
+        return 0;
+    }
+    return Scheduler_Tasks[task_id].missed;
+}
+
+void Scheduler_Reset_Stats(void){
+    for (uint8_t i = 0; i < Scheduler_Task_Count; i++) {
+        Scheduler_Tasks[i].wcet = 0;
+        Scheduler_Tasks[i].missed = 0;
+    }
+}
@@ -0,0 +1,42 @@
+/* 
+ * File:   Scheduler.h
+ * Author: Mostafa Eshra
+ *
+ * Description: Cooperative task scheduler driven by the Timer0 overflow tick.
+ */
+
+#ifndef SCHEDULER_H
+#define	SCHEDULER_H
+
+#include <stdint.h>
+
+// Maximum number of tasks that can be registered
+#define SCHEDULER_MAX_TASKS    4
+
+// One tick = one Timer0 overflow = 256 timer counts.
+// With F_CPU = 16 MHz and TIMER0_CS_PRE_64: 1 count = 4 us, 1 tick = 1.024 ms
+#define SCHEDULER_COUNT_US     4
+#define SCHEDULER_MS_TO_TICKS(ms)   ((uint16_t)(((ms) * 1000UL) / (256UL * SCHEDULER_COUNT_US)))
+
+#define SCHEDULER_INVALID_TASK 0xFF
+
+// Tasks must run to completion without blocking (no busy delays)
+typedef void (*Scheduler_Task_Fn)(void);
+
+void    Scheduler_Init(void);
+// Lower task ids (registration order) have higher priority.
+// period and deadline are in ticks, deadline is counted from the release time.
+uint8_t Scheduler_Add_Task(Scheduler_Task_Fn task, uint16_t period, uint16_t deadline);
+// Dispatches the highest priority ready task, call it from the main loop
+void    Scheduler_Run(void);
+// Called by the running task instead of waiting: it runs again on the next
+// tick within the same release (the deadline still counts from the release)
+void    Scheduler_Retry(void);
+
+// Worst-case run time of a task in timer counts (x SCHEDULER_COUNT_US = us)
+uint16_t Scheduler_Get_WCET(uint8_t task_id);
+// Releases that finished after their deadline or were skipped entirely
+uint16_t Scheduler_Get_Missed(uint8_t task_id);
+void     Scheduler_Reset_Stats(void);
+
+#endif	/* SCHEDULER_H */
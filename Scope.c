@@ -0,0 +1,129 @@
+/* 
+ * File:   Scope.c
+ * Author: Mostafa Eshra
+ */
+
+#include <avr/io.h>
+#include "Scope.h"
+#include "ADC.h"
+#include "Timer.h"
+#include "GLCD.h"
+#include "Scheduler.h"
+#include "View.h"
+
+// Only built for the scope view, the buffer would take SRAM from the others
+#if DISPLAY_VIEW == DISPLAY_VIEW_SCOPE
+
+static uint8_t  Scope_Buffer[SCOPE_SAMPLES];
+static uint32_t Scope_Rate = 0;
+
+static uint8_t  Scope_Saved_ADMUX;
+static uint8_t  Scope_Saved_ADCSRA;
+
+void Scope_Capture_Start(char ADC_CH, char ADC_PRE, uint8_t trigger_level, uint8_t edge) {
+    Scope_Saved_ADMUX = ADMUX;
+    Scope_Saved_ADCSRA = ADCSRA;
+
+    // Take the ADC over: left adjusted (8-bit read of ADCH), free running at
+    // the requested prescaler, the ADC ISR waits for the trigger and fills
+    // the buffer
+    ADC_Stop_FreeRunning();
+    ADC_select_CH(ADC_CH);
+    ADMUX |= (1 << ADLAR);
+    ADC_select_PRE(ADC_PRE);
+    ADC_Start_Burst(Scope_Buffer, SCOPE_SAMPLES, trigger_level, edge, SCOPE_TRIGGER_TIMEOUT);
+}
+
+uint8_t Scope_Capture_Poll(void) {
+    if (!ADC_Burst_Done()) {
+        return SCOPE_BUSY;
+    }
+
+    // Timestamps count in SCHEDULER_COUNT_US steps
+    uint32_t elapsed = ADC_Burst_Get_Time();
+    if (elapsed != 0) {
+        Scope_Rate = (SCOPE_SAMPLES * 1000000UL) / (elapsed * SCHEDULER_COUNT_US);
+    }
+
+    // Give the ADC back in the mode it was in
+    while (ADCSRA & (1 << ADSC));
+    ADMUX = Scope_Saved_ADMUX;
+    ADCSRA = (Scope_Saved_ADCSRA & ~((1 << ADATE) | (1 << ADIE) | (1 << ADSC))) | (1 << ADIF);
+    if (Scope_Saved_ADCSRA & (1 << ADIE)) {
+        ADC_Restart();
+    }
+
+    return ADC_Burst_Triggered() ? SCOPE_TRIGGERED : SCOPE_AUTO;
+}
+
+uint32_t Scope_Get_Sample_Rate(void) {
+    return Scope_Rate;
+}
+
+// Maps a sample to a pixel row (0 = top) inside a trace area of height rows
+static uint8_t Scope_Sample_To_Row(uint8_t sample, uint8_t volt_div, uint8_t height) {
+    int16_t v = 128 + ((int16_t)sample - 128) * volt_div;
+    if (v < 0) {
+        v = 0;
+    } else if (v > 255) {
+        v = 255;
+    }
+    return (height - 1) - (uint8_t)(((uint16_t)v * height) >> 8);
+}
+
+void Scope_Render(uint8_t first_page, uint8_t last_page,
+                  uint8_t time_div, uint8_t volt_div, uint8_t grid) {
+    uint8_t height = (last_page - first_page + 1) * 8;
+    uint8_t previous_row = 0xFF;
+
+    if (time_div == 0) {
+        time_div = 1;
+    }
+
+    uint8_t index = 0;
+    uint8_t repeat = 0;
+
+    for (uint8_t column = 0; column < GLCD_WIDTH; column++) {
+        uint8_t row = Scope_Sample_To_Row(Scope_Buffer[index], volt_div, height);
+
+        // Next sample after time_div columns
+        if (++repeat >= time_div) {
+            repeat = 0;
+            index++;
+        }
+
+        // Vertical extent of this column: the sample, joined to the previous one
+        uint8_t top = row;
+        uint8_t bottom = row;
+        if (previous_row != 0xFF) {
+            if (previous_row < top) {
+                top = previous_row;
+            } else if (previous_row > bottom) {
+                bottom = previous_row;
+            }
+        }
+        previous_row = row;
+
+        // Build each page byte of the column and write it once
+        for (uint8_t p = 0; p <= (last_page - first_page); p++) {
+            uint8_t y0 = p * 8;
+            uint8_t data = 0x00;
+
+            if (grid && (column & 15) == 0) {
+                data = 0x55;            // Dotted vertical division
+            } else if (grid && (column & 3) == 0) {
+                data = 0x01;            // Dotted horizontal division (top row of page)
+            }
+
+            // Trace pixels: rows top..bottom that fall inside this page
+            if (bottom >= y0 && top <= y0 + 7) {
+                uint8_t lo = (top > y0) ? (top - y0) : 0;
+                uint8_t hi = (bottom < y0 + 7) ? (bottom - y0) : 7;
+                data |= (uint8_t)(0xFF << lo) & (uint8_t)(0xFF >> (7 - hi));
+            }
+            GLCD_WriteByte(first_page + p, column, data);
+        }
+    }
+}
+
+#endif /* DISPLAY_VIEW == DISPLAY_VIEW_SCOPE */
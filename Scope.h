@@ -0,0 +1,55 @@
+/* 
+ * File:   Scope.h
+ * Author: Mostafa Eshra
+ *
+ * Description: Oscilloscope capture mode: triggered high-rate ADC burst into
+ *              SRAM (8-bit samples), rendered as a trace on the GLCD.
+ */
+
+#ifndef SCOPE_H
+#define	SCOPE_H
+
+#include <stdint.h>
+#include "ADC.h"
+
+// Samples per capture (one per column at 1x horizontal zoom)
+#define SCOPE_SAMPLES            128
+
+// Trigger edge
+#define SCOPE_EDGE_RISING        ADC_BURST_RISING
+#define SCOPE_EDGE_FALLING       ADC_BURST_FALLING
+#define SCOPE_EDGE_NONE          ADC_BURST_NONE   // Free run: capture immediately
+
+// Samples to wait for a trigger before capturing anyway (auto mode)
+#define SCOPE_TRIGGER_TIMEOUT    2048
+
+// Scope_Capture_Poll results
+#define SCOPE_BUSY               0
+#define SCOPE_TRIGGERED          1
+#define SCOPE_AUTO               2   // Timed out, captured untriggered
+
+// Time/div: columns drawn per sample (1, 2, 4 ...) - zooms in horizontally
+// Volts/div: vertical gain around mid-scale (1 = full ADC range on screen)
+#define SCOPE_TIME_1X            1
+#define SCOPE_TIME_2X            2
+#define SCOPE_TIME_4X            4
+#define SCOPE_GAIN_1X            1
+#define SCOPE_GAIN_2X            2
+#define SCOPE_GAIN_4X            4
+
+// Starts capturing SCOPE_SAMPLES 8-bit samples from ADC_CH with prescaler
+// ADC_PRE (ADC_PRE_16 or faster for high rates) and returns at once: the ADC
+// ISR waits for the trigger and fills the buffer (ADC.h burst capture). The
+// normal ADC mode is paused until Scope_Capture_Poll gives it back.
+void     Scope_Capture_Start(char ADC_CH, char ADC_PRE, uint8_t trigger_level, uint8_t edge);
+// SCOPE_BUSY while the capture runs, then SCOPE_TRIGGERED or SCOPE_AUTO once
+// the buffer is full (the ADC is restored on that call)
+uint8_t  Scope_Capture_Poll(void);
+// Measured sample rate of the last capture, in samples per second
+uint32_t Scope_Get_Sample_Rate(void);
+// Draws the last capture on pages first_page..last_page (framebuffer only),
+// with a dotted grid every 16 columns / 8 rows if grid is non-zero
+void     Scope_Render(uint8_t first_page, uint8_t last_page,
+                      uint8_t time_div, uint8_t volt_div, uint8_t grid);
+
+#endif	/* SCOPE_H */
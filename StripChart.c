@@ -0,0 +1,85 @@
+/* 
+ * File:   StripChart.c
+ * Author: Mostafa Eshra
+ */
+
+#include "StripChart.h"
+#include "View.h"
+
+// Only built for the strip chart view, the row tables would take SRAM from
+// the others
+#if DISPLAY_VIEW == DISPLAY_VIEW_STRIP_CHART
+
+// Scrolling works on the panel RAM rows: with start line S, screen row 0
+// shows RAM row S, so moving S down by one brings the oldest row (RAM row S)
+// to the bottom of the screen. Each sample therefore rewrites just that one
+// RAM row: erase the old segment stored in it, draw the new one. The cost
+// per sample is O(segment length), not O(history).
+
+static uint8_t StripChart_Line = 0;         // Current start line
+static uint8_t StripChart_Last = 0xFF;      // Previous sample (0xFF = none)
+
+// Segment drawn on each RAM row: columns lo..hi (lo = 0xFF means empty)
+static uint8_t StripChart_Lo[STRIPCHART_ROWS];
+static uint8_t StripChart_Hi[STRIPCHART_ROWS];
+
+// Sets or clears columns lo..hi of one RAM row in the chart area
+static void StripChart_Draw_Row(uint8_t row, uint8_t lo, uint8_t hi, uint8_t on) {
+    uint8_t page = row >> 3;
+    uint8_t mask = 1 << (row & 7);
+
+    for (uint8_t c = lo; c <= hi; c++) {
+        uint8_t column = STRIPCHART_FIRST_COL + c;
+        uint8_t data = GLCD_ReadByte(page, column);
+        GLCD_WriteByte(page, column, on ? (data | mask) : (data & ~mask));
+    }
+}
+
+void StripChart_Init(void) {
+    for (uint8_t page = 0; page < GLCD_PAGES; page++) {
+        for (uint8_t c = 0; c < STRIPCHART_WIDTH; c++) {
+            GLCD_WriteByte(page, STRIPCHART_FIRST_COL + c, 0x00);
+        }
+    }
+    for (uint8_t row = 0; row < STRIPCHART_ROWS; row++) {
+        StripChart_Lo[row] = 0xFF;
+    }
+
+    StripChart_Line = 0;
+    StripChart_Last = 0xFF;
+    GLCD_SetStartLine(STRIPCHART_CHIP, 0);
+}
+
+void StripChart_Push(uint8_t value) {
+    uint8_t row = StripChart_Line; // Oldest row, about to become the bottom one
+
+    if (value >= STRIPCHART_WIDTH) {
+        value = STRIPCHART_WIDTH - 1;
+    }
+
+    // 1. Erase what this row showed 64 samples ago
+    if (StripChart_Lo[row] != 0xFF) {
+        StripChart_Draw_Row(row, StripChart_Lo[row], StripChart_Hi[row], 0);
+    }
+
+    // 2. Draw the new segment, joined horizontally to the previous sample
+    uint8_t lo = value;
+    uint8_t hi = value;
+    if (StripChart_Last != 0xFF) {
+        if (StripChart_Last < lo) {
+            lo = StripChart_Last;
+        } else if (StripChart_Last > hi) {
+            hi = StripChart_Last;
+        }
+    }
+    StripChart_Draw_Row(row, lo, hi, 1);
+    StripChart_Lo[row] = lo;
+    StripChart_Hi[row] = hi;
+    StripChart_Last = value;
+
+    // 3. Scroll by one row
+    StripChart_Line = (row + 1) & (STRIPCHART_ROWS - 1);
+    GLCD_SetStartLine(STRIPCHART_CHIP, StripChart_Line);
+}
+
+#endif /* DISPLAY_VIEW == DISPLAY_VIEW_STRIP_CHART */
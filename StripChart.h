@@ -0,0 +1,29 @@
+/* 
+ * File:   StripChart.h
+ * Author: Mostafa Eshra
+ *
+ * Description: Rolling strip chart on one GLCD half, scrolled in hardware
+ *              with the KS0108 start-line register.
+ */
+
+#ifndef STRIPCHART_H
+#define	STRIPCHART_H
+
+#include <stdint.h>
+#include "GLCD.h"
+
+// The chart owns the whole right half (columns 64-127, all 8 pages).
+// Time runs upwards (newest sample on the bottom row), the value runs
+// left to right across the 64 columns.
+#define STRIPCHART_CHIP        GLCD_CHIP_2
+#define STRIPCHART_FIRST_COL   (GLCD_WIDTH / 2)
+#define STRIPCHART_WIDTH       (GLCD_WIDTH / 2)
+#define STRIPCHART_ROWS        GLCD_HEIGHT
+
+// Clears the chart area and resets the scroll position
+void StripChart_Init(void);
+// Adds one sample (0 to STRIPCHART_WIDTH-1): scrolls one row and draws only
+// that row, joined to the previous sample. Shown on the next GLCD_Flush().
+void StripChart_Push(uint8_t value);
+
+#endif	/* STRIPCHART_H */
@@ -4,12 +4,30 @@
  */
 
 #include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
 #include "Timer.h"
 
 #include "DIO.h"
 
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+#if TIMER0_DITHER
+// --- Timer0 Dithering State (read by the overflow ISR) ---
+static volatile uint8_t Timer0_Dither_On = 0;
+static volatile uint8_t Timer0_Dither_Base = 0;   // integer part of the duty
+static volatile uint8_t Timer0_Dither_Frac = 0;   // fractional part, /256
+static uint8_t Timer0_Dither_Acc = 0;             // ISR only
+#endif
+
 void init_Timer0(char TIMER_MODE, char TIMER_CLOCK_SOURCE) {
 
+#if TIMER0_ISR_PROFILE
+    DIO_FAST_PIN_OUTPUT(DDRB, PB0);
+#endif
+
     // TCCR0
     switch (TIMER_MODE) {
         case TIMER0_MODE_NORMAL:
@@ -42,9 +60,29 @@ void Timer0_INT_ENABLE(char TIMER_INT) {
 }
 
 void Timer0_SET_COMP_VAL(char TIMER_COMP_VAL) {
+#if TIMER0_DITHER
+    Timer0_Dither_On = 0;
+#endif
     OCR0 = TIMER_COMP_VAL;
 }
 
+#if TIMER0_DITHER
+void Timer0_SET_DUTY16(uint16_t TIMER_DUTY) {
+    uint8_t base = (uint8_t)(TIMER_DUTY >> 8);
+    uint8_t frac = (uint8_t)TIMER_DUTY;
+
+    // OCR0 = 255 is already 100%, there is no next step to dither towards
+    if (base == 0xFF) {
+        frac = 0;
+    }
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        Timer0_Dither_Base = base;
+        Timer0_Dither_Frac = frac;
+        Timer0_Dither_On = 1;
+    }
+}
+#endif
+
 void Timer0_COMP_MODE(char TIMER0_COMP_MODE){
     switch(TIMER0_COMP_MODE){
         case TIMER0_COMP_MODE_CTC_TOGGLE:
@@ -57,4 +95,257 @@ void Timer0_COMP_MODE(char TIMER0_COMP_MODE){
             TCCR0 &= ~(1 << COM00);
             break;
     }
+}
+
+// --- Timer2 ---
+
+void init_Timer2(char TIMER_MODE, char TIMER_CLOCK_SOURCE) {
+
+    // TCCR2
+    switch (TIMER_MODE) {
+        case TIMER2_MODE_NORMAL:
+            TCCR2 &= ~((1 << WGM21) | (1 << WGM20));
+            break;
+        case TIMER2_MODE_PWM:
+            TCCR2 &= ~((1 << WGM21) | (1 << WGM20));
+            TCCR2 |= (1 << WGM20);
+            break;
+        case TIMER2_MODE_CTC:
+            TCCR2 &= ~((1 << WGM21) | (1 << WGM20));
+            TCCR2 |= (1 << WGM21);
+            break;
+        case TIMER2_MODE_FPWM:
+            TCCR2 |= ((1 << WGM21) | (1 << WGM20));
+            break;
+    }
+    TCCR2 &= ~((1 << CS22) | (1 << CS21) | (1 << CS20));
+    TCCR2 |= TIMER_CLOCK_SOURCE;
+}
+
+void Timer2_INT_ENABLE(char TIMER_INT) {
+    switch (TIMER_INT) {
+        case TIMER2_INT_TOV:
+            TIMSK |= (1 << TOIE2);
+            break;
+        case TIMER2_INT_OCF:
+            TIMSK |= (1 << OCIE2);
+            break;
+    }
+}
+
+void Timer2_INT_DISABLE(char TIMER_INT) {
+    switch (TIMER_INT) {
+        case TIMER2_INT_TOV:
+            TIMSK &= ~(1 << TOIE2);
+            break;
+        case TIMER2_INT_OCF:
+            TIMSK &= ~(1 << OCIE2);
+            break;
+    }
+}
+
+void Timer2_SET_COMP_VAL(char TIMER_COMP_VAL) {
+    OCR2 = TIMER_COMP_VAL;
+}
+
+void Timer2_COMP_MODE(char TIMER2_COMP_MODE){
+    switch(TIMER2_COMP_MODE){
+        case TIMER2_COMP_MODE_CTC_TOGGLE:
+            DIO_Set_PIN_DIR(&PORTD, PD7, OUTPUT);
+            TCCR2 |= (1<<COM20);
+            break;
+        case TIMER2_COMP_MODE_PWM_SET_ON_COUNT_UP:
+            DIO_Set_PIN_DIR(&PORTD, PD7, OUTPUT);
+            TCCR2 |= (1 << COM21);
+            TCCR2 &= ~(1 << COM20);
+            break;
+    }
+}
+
+// --- Timer1 ---
+
+void init_Timer1(char TIMER_MODE, char TIMER_CLOCK_SOURCE) {
+
+    // WGM11:10 live in TCCR1A, WGM13:12 in TCCR1B
+    TCCR1A = (TCCR1A & ~((1 << WGM11) | (1 << WGM10))) | (TIMER_MODE & 0x03);
+    TCCR1B = (TCCR1B & ~((1 << WGM13) | (1 << WGM12) | (1 << CS12) | (1 << CS11) | (1 << CS10)))
+           | ((TIMER_MODE & 0x0C) << 1)
+           | TIMER_CLOCK_SOURCE;
+}
+
+void Timer1_INT_ENABLE(char TIMER_INT) {
+    switch (TIMER_INT) {
+        case TIMER1_INT_TOV:
+            TIMSK |= (1 << TOIE1);
+            break;
+        case TIMER1_INT_OCF_A:
+            TIMSK |= (1 << OCIE1A);
+            break;
+        case TIMER1_INT_OCF_B:
+            TIMSK |= (1 << OCIE1B);
+            break;
+        case TIMER1_INT_ICF:
+            TIMSK |= (1 << TICIE1);
+            break;
+    }
+}
+
+// 16-bit registers share the TEMP byte, so writes are kept atomic
+void Timer1_SET_COMP_VAL(char TIMER1_CH, uint16_t TIMER_COMP_VAL) {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        if (TIMER1_CH == TIMER1_CH_A) {
+            OCR1A = TIMER_COMP_VAL;
+        } else {
+            OCR1B = TIMER_COMP_VAL;
+        }
+    }
+}
+
+void Timer1_COMP_MODE(char TIMER1_CH, char TIMER1_COMP_MODE){
+    switch(TIMER1_CH){
+        case TIMER1_CH_A:
+            if (TIMER1_COMP_MODE != TIMER1_COMP_MODE_DISCONNECTED) {
+                DIO_Set_PIN_DIR(&PORTD, PD5, OUTPUT);
+            }
+            TCCR1A = (TCCR1A & ~((1 << COM1A1) | (1 << COM1A0))) | (TIMER1_COMP_MODE << COM1A0);
+            break;
+        case TIMER1_CH_B:
+            if (TIMER1_COMP_MODE != TIMER1_COMP_MODE_DISCONNECTED) {
+                DIO_Set_PIN_DIR(&PORTD, PD4, OUTPUT);
+            }
+            TCCR1A = (TCCR1A & ~((1 << COM1B1) | (1 << COM1B0))) | (TIMER1_COMP_MODE << COM1B0);
+            break;
+    }
+}
+
+void Timer1_SET_TOP(uint16_t TIMER_TOP) {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        ICR1 = TIMER_TOP;
+    }
+}
+
+uint16_t Timer1_GET_TOP(void) {
+    uint16_t top;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        top = ICR1;
+    }
+    return top;
+}
+
+uint8_t Timer1_SET_PWM_FREQ(char TIMER_MODE, uint32_t PWM_FREQ_HZ) {
+    static const uint16_t prescalers[] = {1, 8, 64, 256, 1024};
+    uint32_t top = 0;
+    uint8_t cs;
+
+    if (PWM_FREQ_HZ == 0 || (TIMER_MODE != TIMER1_MODE_FPWM_ICR && TIMER_MODE != TIMER1_MODE_PWM_ICR)) {
+        return 0;
+    }
+
+    // Smallest prescaler whose TOP fits in 16 bits gives the best resolution
+    // Fast PWM:          f = F_CPU / (N * (1 + TOP))
+    // Phase correct PWM: f = F_CPU / (2 * N * TOP)
+    for (cs = 0; cs < 5; cs++) {
+        if (TIMER_MODE == TIMER1_MODE_FPWM_ICR) {
+            top = F_CPU / ((uint32_t)prescalers[cs] * PWM_FREQ_HZ) - 1;
+        } else {
+            top = F_CPU / (2UL * prescalers[cs] * PWM_FREQ_HZ);
+        }
+        if (top <= 0xFFFF) {
+            break;
+        }
+    }
+    if (cs == 5 || top < 3) {
+        return 0; // Too slow even at /1024, or too fast for 2-bit resolution
+    }
+
+    Timer1_SET_TOP((uint16_t)top);
+    init_Timer1(TIMER_MODE, TIMER1_CS_NO_PRE + cs);
+
+    // Resolution = log2(TOP + 1), rounded down
+    uint8_t bits = 0;
+    for (uint32_t steps = top + 1; steps > 1; steps >>= 1) {
+        bits++;
+    }
+    return bits;
+}
+
+// --- Timer0 Overflow Tick ---
+
+static volatile uint16_t Timer0_Ticks = 0;
+
+#if TIMER0_ISR_PROFILE
+static volatile uint16_t Timer0_ISR_Max = 0;
+#endif
+
+// Runs every 256 timer counts (1.024 ms at /64). The dither step is straight
+// line code apart from the on/off test: one 8-bit add, the carry picks OCR0
+// or OCR0 + 1, and OCR0 is double buffered so the write takes effect at the
+// next BOTTOM. The average duty over 256 periods is base + frac / 256.
+ISR(TIMER0_OVF_vect){
+#if TIMER0_ISR_PROFILE
+    // Timer1 counts CPU cycles; no Timer1 ISR can run in between, and the
+    // main-level 16-bit Timer1 accesses are atomic, so TEMP is safe here
+    uint16_t entry = TCNT1;
+    DIO_FAST_PIN_HIGH(PORTB, PB0);
+#endif
+    Timer0_Ticks++;
+
+#if TIMER0_DITHER
+    if (Timer0_Dither_On) {
+        uint8_t acc = Timer0_Dither_Acc;
+        uint8_t ocr = Timer0_Dither_Base;
+        // Carry out of the accumulator -> one period at the next step up
+#if defined(__AVR__)
+        __asm__ ("add %0, %2"               "\n\t"
+                 "adc %1, __zero_reg__"
+                 : "+r" (acc), "+r" (ocr)
+                 : "r" (Timer0_Dither_Frac));
+#else
+        ocr += (uint8_t)(acc + Timer0_Dither_Frac) < acc;
+        acc += Timer0_Dither_Frac;
+#endif
+        OCR0 = ocr;
+        Timer0_Dither_Acc = acc;
+    }
+#endif
+
+#if TIMER0_ISR_PROFILE
+    DIO_FAST_PIN_LOW(PORTB, PB0);
+    uint16_t cycles = (TCNT1 - entry) & 0x03FF;
+    if (cycles > Timer0_ISR_Max) {
+        Timer0_ISR_Max = cycles;
+    }
+#endif
+}
+
+#if TIMER0_ISR_PROFILE
+uint16_t Timer0_Get_ISR_Max(void){
+    uint16_t cycles;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        cycles = Timer0_ISR_Max;
+    }
+    return cycles;
+}
+#endif
+
+uint16_t Timer0_Get_Ticks(void){
+    uint16_t ticks;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        ticks = Timer0_Ticks;
+    }
+    return ticks;
+}
+
+uint32_t Timer0_Get_Timestamp(void){
+    uint16_t ticks;
+    uint8_t count;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        ticks = Timer0_Ticks;
+        count = TCNT0;
+        // Overflow happened but its ISR has not run yet
+        if ((TIFR & (1 << TOV0)) && count < 128) {
+            ticks++;
+        }
+    }
+    return ((uint32_t)ticks << 8) | count;
 }
\ No newline at end of file
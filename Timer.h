@@ -28,20 +28,117 @@
 #define TIMER0_COMP_MODE_CTC_TOGGLE  1
 #define TIMER0_COMP_MODE_PWM_SET_ON_COUNT_UP  2
 
+// Sigma-delta dithering of OCR0 in the overflow ISR (Timer0_SET_DUTY16).
+// Worst case (dithering on) the step costs 15 cycles, counted per
+// instruction from the AVR instruction set timings: 4 x lds (8), tst + breq
+// (2), add + adc (2, inline asm on the target), out OCR0 (1), sts (2).
+// Register saves the compiler adds to the ISR prologue come on top;
+// TIMER0_ISR_PROFILE measures the whole body.
+#ifndef TIMER0_DITHER
+#define TIMER0_DITHER        1
+#endif
+// Set to 1 to profile the overflow ISR: PB0 is high while it runs and the
+// worst body time in CPU cycles is kept (Timer0_Get_ISR_Max), taken from
+// TCNT1 on entry and exit. Needs Timer1 at /1 in TIMER1_MODE_FPWM_10BIT
+// (as main.c sets it up), so the difference is exact modulo 1024.
+#ifndef TIMER0_ISR_PROFILE
+#define TIMER0_ISR_PROFILE   0
+#endif
+
+// --- Timer2 (8-bit, output OC2 on PD7) ---
+// Taken by the GLCD bus queue (compare interrupt) when GLCD_QUEUE is 1
+// Timer Modes (same WGM layout as Timer0)
+#define TIMER2_MODE_NORMAL   0
+#define TIMER2_MODE_PWM      1
+#define TIMER2_MODE_CTC      2
+#define TIMER2_MODE_FPWM     3
+// Clock Source (Timer2 has its own prescaler steps)
+#define TIMER2_CS_STOP       0
+#define TIMER2_CS_NO_PRE     1
+#define TIMER2_CS_PRE_8      2
+#define TIMER2_CS_PRE_32     3
+#define TIMER2_CS_PRE_64     4
+#define TIMER2_CS_PRE_128    5
+#define TIMER2_CS_PRE_256    6
+#define TIMER2_CS_PRE_1024   7
+// Enable Individual Interrupts
+#define TIMER2_INT_TOV               0
+#define TIMER2_INT_OCF               1
+
+#define TIMER2_COMP_MODE_CTC_TOGGLE  1
+#define TIMER2_COMP_MODE_PWM_SET_ON_COUNT_UP  2
+
+// --- Timer1 (16-bit, outputs OC1A on PD5 and OC1B on PD4) ---
+// Timer Modes (value = WGM13:0)
+#define TIMER1_MODE_NORMAL       0
+#define TIMER1_MODE_CTC          4    // TOP = OCR1A
+#define TIMER1_MODE_FPWM_10BIT   7    // Fast PWM, TOP = 0x03FF (ICR1 stays free)
+#define TIMER1_MODE_PWM_ICR      10   // Phase correct PWM, TOP = ICR1
+#define TIMER1_MODE_FPWM_ICR     14   // Fast PWM, TOP = ICR1
+// Clock Source
+#define TIMER1_CS_STOP       0
+#define TIMER1_CS_NO_PRE     1
+#define TIMER1_CS_PRE_8      2
+#define TIMER1_CS_PRE_64     3
+#define TIMER1_CS_PRE_256    4
+#define TIMER1_CS_PRE_1024   5
+#define TIMER1_EXT_CS_FALLING_EDGE   6
+#define TIMER1_EXT_CS_RISING_EDGE    7
+// Enable Individual Interrupts
+#define TIMER1_INT_TOV               0
+#define TIMER1_INT_OCF_A             1
+#define TIMER1_INT_OCF_B             2
+#define TIMER1_INT_ICF               3
+// Output Compare Channels
+#define TIMER1_CH_A                  0
+#define TIMER1_CH_B                  1
+// Compare Output Modes
+#define TIMER1_COMP_MODE_DISCONNECTED        0
+#define TIMER1_COMP_MODE_TOGGLE              1
+#define TIMER1_COMP_MODE_PWM_NON_INVERTING   2   // Clear on match, set at BOTTOM
+#define TIMER1_COMP_MODE_PWM_INVERTING       3   // Set on match, clear at BOTTOM
+
+
+#include <stdint.h>
 
 void init_Timer0(char TIMER_MODE, char TIMER_CLOCK_SOURCE);
 void Timer0_INT_ENABLE(char TIMER_INT);
 void Timer0_SET_COMP_VAL(char TIMER_COMP_VAL);
 void Timer0_COMP_MODE(char TIMER0_COMP_MODE);
+// Overflow tick counter (needs Timer0_INT_ENABLE(TIMER0_INT_TOV) and sei())
+uint16_t Timer0_Get_Ticks(void);
+// Ticks and TCNT0 combined: (ticks << 8) | TCNT0, in timer clock counts
+uint32_t Timer0_Get_Timestamp(void);
+#if TIMER0_DITHER
+// 8.8 fixed-point duty: high byte is OCR0, low byte the fraction spread over
+// the next 256 PWM periods (10-bit ADC: DUTY16 = adc << 6).
+// Timer0_SET_COMP_VAL() switches dithering off again.
+void Timer0_SET_DUTY16(uint16_t TIMER_DUTY);
+#endif
+#if TIMER0_ISR_PROFILE
+// Worst ISR body time in CPU cycles (62.5 ns at 16 MHz), entry latency and
+// the prologue/epilogue not included
+uint16_t Timer0_Get_ISR_Max(void);
+#endif
+
+
 void init_Timer2(char TIMER_MODE, char TIMER_CLOCK_SOURCE);
 void Timer2_INT_ENABLE(char TIMER_INT);
+void Timer2_INT_DISABLE(char TIMER_INT);
 void Timer2_SET_COMP_VAL(char TIMER_COMP_VAL);
-void Timer2_COMP_MODE(char TIMER0_COMP_MODE);
+void Timer2_COMP_MODE(char TIMER2_COMP_MODE);
 
 
 void init_Timer1(char TIMER_MODE, char TIMER_CLOCK_SOURCE);
 void Timer1_INT_ENABLE(char TIMER_INT);
-void Timer1_SET_COMP_VAL(char TIMER_COMP_VAL);
-void Timer1_COMP_MODE(char TIMER0_COMP_MODE);
+void Timer1_SET_COMP_VAL(char TIMER1_CH, uint16_t TIMER_COMP_VAL);
+void Timer1_COMP_MODE(char TIMER1_CH, char TIMER1_COMP_MODE);
+// TOP for the ICR1 modes (TIMER1_MODE_FPWM_ICR / TIMER1_MODE_PWM_ICR)
+void Timer1_SET_TOP(uint16_t TIMER_TOP);
+uint16_t Timer1_GET_TOP(void);
+// Picks prescaler and TOP (ICR1) for the requested PWM frequency in one of the
+// ICR1 modes and starts Timer1. Returns the resulting resolution in bits
+// (0 if the frequency cannot be reached).
+uint8_t Timer1_SET_PWM_FREQ(char TIMER_MODE, uint32_t PWM_FREQ_HZ);
 
 #endif	/* TIMER_H */
\ No newline at end of file
@@ -0,0 +1,32 @@
+/* 
+ * File:   View.h
+ * Author: Mostafa Eshra
+ *
+ * Description: Selects the screen main.c builds. Modules only one view
+ *              uses keep their RAM buffers out of the other views.
+ */
+
+#ifndef VIEW_H
+#define	VIEW_H
+
+// --- Screen Layout ---
+// WAVEFORM:    label + percent on page 0, one PWM period per half on pages 5-6
+// STRIP_CHART: label + percent on the left half, duty history scrolling on
+//              the right half (hardware scrolled, one row per sample)
+// SCOPE:       triggered capture of SCOPE_CHANNEL drawn on pages 1-7, sample
+//              rate on page 0 (the duty readout is not shown)
+#define DISPLAY_VIEW_WAVEFORM     0
+#define DISPLAY_VIEW_STRIP_CHART  1
+#define DISPLAY_VIEW_SCOPE        2
+
+#ifndef DISPLAY_VIEW
+#define DISPLAY_VIEW           DISPLAY_VIEW_WAVEFORM
+#endif
+
+// Static RAM of the WAVEFORM view, counted from the declarations (bytes):
+// GLCD 1280 (framebuffer 1024, dirty map 128, queue 64), Widget 232,
+// ADC 98, Scheduler 58, Capture 33, Filter 24, the rest ~30: ~1755 of the
+// 2048, the remainder holds const data, string literals and the stack.
+// Scope (132) and StripChart (130) only exist in their own view.
+
+#endif	/* VIEW_H */
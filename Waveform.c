@@ -0,0 +1,140 @@
+/*
+ * File:   Waveform.c
+ * Author: Mostafa Eshra
+ */
+
+#include "Waveform.h"
+
+// Column kinds inside one period
+#define WAVEFORM_COL_HIGH   0
+#define WAVEFORM_COL_LOW    1
+#define WAVEFORM_COL_EDGE   2
+
+// Bits of rows first..last (pixel rows, inclusive) that fall into page
+static uint8_t Waveform_Rows_Mask(uint8_t page, uint8_t first, uint8_t last) {
+    uint8_t top = page * 8;
+    uint8_t mask = 0;
+
+    for (uint8_t bit = 0; bit < 8; bit++) {
+        uint8_t row = top + bit;
+        if (row >= first && row <= last) {
+            mask |= (uint8_t)(1 << bit);
+        }
+    }
+    return mask;
+}
+
+void Waveform_Init(Waveform* wf, uint8_t first_page, uint8_t last_page,
+                   uint8_t column, uint8_t width, uint8_t periods,
+                   uint8_t amplitude, uint8_t grid) {
+    if (last_page >= GLCD_PAGES) {
+        last_page = GLCD_PAGES - 1;
+    }
+    if (first_page > last_page) {
+        first_page = last_page;
+    }
+    if ((uint16_t)column + width > GLCD_WIDTH) {
+        width = GLCD_WIDTH - column;
+    }
+    if (periods == 0) {
+        periods = 1;
+    }
+
+    wf->first_page = first_page;
+    wf->pages = last_page - first_page + 1;
+    wf->column = column;
+    wf->periods = periods;
+    wf->period = width / periods;
+    wf->grid = grid;
+
+    // Rows relative to the top of the span
+    uint8_t rows = wf->pages * 8;
+    if (amplitude < 2 || amplitude > rows) {
+        amplitude = rows;
+    }
+    uint8_t top = (rows - amplitude) / 2;
+    uint8_t bottom = top + amplitude - 1;
+    uint8_t middle = (top + bottom) / 2;
+
+    for (uint8_t p = 0; p < wf->pages; p++) {
+        wf->pattern_high[p] = Waveform_Rows_Mask(p, top, top);
+        wf->pattern_low[p] = Waveform_Rows_Mask(p, bottom, bottom);
+        wf->pattern_edge[p] = Waveform_Rows_Mask(p, top, bottom);
+        wf->pattern_grid_row[p] = Waveform_Rows_Mask(p, middle, middle);
+        wf->pattern_grid_column[p] = Waveform_Rows_Mask(p, top, bottom) & 0x55;
+    }
+
+    Waveform_Invalidate(wf);
+}
+
+uint8_t Waveform_Period_Width(const Waveform* wf) {
+    return wf->period;
+}
+
+void Waveform_Invalidate(Waveform* wf) {
+    wf->high = wf->period + 1;
+}
+
+// Kind of column c (0..period-1) of a period for `high` high columns: high
+// part, falling edge at `high`, low part, and a rising edge in the last
+// column when another period follows
+static uint8_t Waveform_Column_Kind(const Waveform* wf, uint8_t c, uint8_t high, uint8_t last_period) {
+    if (high == 0) {
+        return WAVEFORM_COL_LOW;
+    }
+    if (high >= wf->period) {
+        return WAVEFORM_COL_HIGH;
+    }
+    if (c == high || (c == wf->period - 1 && !last_period)) {
+        return WAVEFORM_COL_EDGE;
+    }
+    return (c < high) ? WAVEFORM_COL_HIGH : WAVEFORM_COL_LOW;
+}
+
+void Waveform_Draw(Waveform* wf, uint8_t high) {
+    uint8_t from = 0;
+    uint8_t to = wf->period - 1;
+
+    if (wf->period == 0) {
+        return;
+    }
+    if (high > wf->period) {
+        high = wf->period;
+    }
+    if (high == wf->high) {
+        return;     // Nothing changed
+    }
+
+    // Both old and new duty have both edges: only the columns between the two
+    // falling edges differ (the rising edges stay where they are)
+    if (wf->high > 0 && wf->high < wf->period && high > 0 && high < wf->period) {
+        from = (high < wf->high) ? high : wf->high;
+        to = (high < wf->high) ? wf->high : high;
+    }
+    wf->high = high;
+
+    const uint8_t* patterns[3] = { wf->pattern_high, wf->pattern_low, wf->pattern_edge };
+
+    for (uint8_t k = 0; k < wf->periods; k++) {
+        uint8_t last_period = (k == wf->periods - 1);
+        uint8_t base = wf->column + k * wf->period;
+
+        for (uint8_t c = from; c <= to; c++) {
+            const uint8_t* pattern = patterns[Waveform_Column_Kind(wf, c, high, last_period)];
+            uint8_t offset = k * wf->period + c;
+            uint8_t grid_column = wf->grid && (offset % WAVEFORM_GRID_STEP) == 0;
+            uint8_t grid_dot = wf->grid && (offset % WAVEFORM_GRID_DOT) == 0;
+
+            for (uint8_t p = 0; p < wf->pages; p++) {
+                uint8_t data = pattern[p];
+                if (grid_column) {
+                    data |= wf->pattern_grid_column[p];
+                }
+                if (grid_dot) {
+                    data |= wf->pattern_grid_row[p];
+                }
+                GLCD_WriteByte(wf->first_page + p, base + c, data);
+            }
+        }
+    }
+}
@@ -0,0 +1,52 @@
+/*
+ * File:   Waveform.h
+ * Author: Mostafa Eshra
+ *
+ * Description: Square wave renderer for the GLCD framebuffer: N periods
+ *              across any column range and page span, any amplitude,
+ *              optional dotted grid.
+ *
+ * The byte patterns of a high, low and edge column are built once per page
+ * by Waveform_Init() and then only streamed. A new duty redraws just the
+ * columns between the old and the new falling edge of each period.
+ */
+
+#ifndef WAVEFORM_H
+#define	WAVEFORM_H
+
+#include <stdint.h>
+#include "GLCD.h"
+
+// Grid: a dot every WAVEFORM_GRID_DOT columns on the middle row, and a
+// dotted vertical line every WAVEFORM_GRID_STEP columns
+#define WAVEFORM_GRID_DOT      4
+#define WAVEFORM_GRID_STEP     16
+
+typedef struct {
+    uint8_t first_page;
+    uint8_t pages;
+    uint8_t column;         // left edge
+    uint8_t period;         // columns per period
+    uint8_t periods;
+    uint8_t grid;
+    uint8_t high;           // high columns on screen, period + 1 = nothing drawn yet
+    uint8_t pattern_high[GLCD_PAGES];
+    uint8_t pattern_low[GLCD_PAGES];
+    uint8_t pattern_edge[GLCD_PAGES];
+    uint8_t pattern_grid_row[GLCD_PAGES];
+    uint8_t pattern_grid_column[GLCD_PAGES];
+} Waveform;
+
+// width columns split into `periods` equal periods (left-over columns stay
+// blank). amplitude is the distance in rows between the high and low level
+// plus one, centered in the page span (0 or too large = the whole span).
+void Waveform_Init(Waveform* wf, uint8_t first_page, uint8_t last_page,
+                   uint8_t column, uint8_t width, uint8_t periods,
+                   uint8_t amplitude, uint8_t grid);
+uint8_t Waveform_Period_Width(const Waveform* wf);
+// high = columns per period at the high level (0..Waveform_Period_Width)
+void Waveform_Draw(Waveform* wf, uint8_t high);
+// Makes the next Waveform_Draw() redraw every column
+void Waveform_Invalidate(Waveform* wf);
+
+#endif	/* WAVEFORM_H */
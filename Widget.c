@@ -0,0 +1,242 @@
+/*
+ * File:   Widget.c
+ * Author: Mostafa Eshra
+ */
+
+#include "Widget.h"
+#include "GLCD.h"
+#include "Format.h"
+#include "Waveform.h"
+#include "Font.h"
+
+// Bar columns: filled / empty part, both with a top and bottom border
+#define WIDGET_BAR_FILL        0x7E
+#define WIDGET_BAR_EMPTY       0x42
+#define WIDGET_BAR_END         0x7E
+
+typedef struct {
+    uint8_t type;
+    uint8_t page;
+    uint8_t pages;
+    uint8_t column;
+    uint8_t width;          // columns
+    uint8_t flags;          // Number: Format.h flags
+    uint8_t digits;         // Number: minimum digits
+    uint8_t wave;           // Trace: Widget_Waves index
+    uint8_t dirty;
+    uint16_t value;
+    uint16_t max;           // Bar / Trace: full scale
+    const char* text;       // Label
+    const Font* font;       // Font number
+} Widget;
+
+static Widget Widget_Table[WIDGET_MAX_COUNT];
+static uint8_t Widget_Count = 0;
+
+static Waveform Widget_Waves[WIDGET_MAX_TRACES];
+static uint8_t Widget_Wave_Count = 0;
+
+static uint8_t Widget_Add(uint8_t type, uint8_t page, uint8_t pages, uint8_t column, uint8_t width){
+    if (Widget_Count >= WIDGET_MAX_COUNT || width == 0
+        || page + pages > GLCD_PAGES || column + width > GLCD_WIDTH) {
+        return WIDGET_INVALID;
+    }
+
+    Widget* w = &Widget_Table[Widget_Count];
+    w->type = type;
+    w->pages = pages;
+    w->page = page;
+    w->column = column;
+    w->width = width;
+    w->flags = 0;
+    w->digits = 0;
+    w->wave = 0;
+    w->dirty = 1;           // Draw once after adding
+    w->value = 0;
+    w->max = 1;
+    w->text = "";
+    w->font = 0;
+    return Widget_Count++;
+}
+
+uint8_t Widget_Add_Label(uint8_t page, uint8_t column, const char* text){
+    uint8_t length = 0;
+    while (text[length] != '\0') {
+        length++;
+    }
+
+    uint8_t id = Widget_Add(WIDGET_LABEL, page, 1, column, length * WIDGET_CHAR_WIDTH);
+    if (id != WIDGET_INVALID) {
+        Widget_Table[id].text = text;
+    }
+    return id;
+}
+
+uint8_t Widget_Add_Number(uint8_t page, uint8_t column, uint8_t digits, uint8_t flags){
+    uint8_t cells = digits + ((flags & FORMAT_PERCENT) ? 1 : 0);
+
+    uint8_t id = Widget_Add(WIDGET_NUMBER, page, 1, column, cells * WIDGET_CHAR_WIDTH);
+    if (id != WIDGET_INVALID) {
+        Widget_Table[id].digits = digits;
+        Widget_Table[id].flags = flags;
+    }
+    return id;
+}
+
+uint8_t Widget_Add_Font_Number(uint8_t page, uint8_t column, uint8_t width, const Font* font, uint8_t flags){
+    uint8_t id = Widget_Add(WIDGET_FONT_NUMBER, page, (font->height + 7) / 8, column, width);
+    if (id != WIDGET_INVALID) {
+        Widget_Table[id].font = font;
+        Widget_Table[id].flags = flags;
+    }
+    return id;
+}
+
+uint8_t Widget_Add_Bar(uint8_t page, uint8_t column, uint8_t width, uint16_t max){
+    uint8_t id = Widget_Add(WIDGET_BAR, page, 1, column, width);
+    if (id != WIDGET_INVALID && max != 0) {
+        Widget_Table[id].max = max;
+    }
+    return id;
+}
+
+uint8_t Widget_Add_Trace(uint8_t page, uint8_t column, uint8_t width, uint8_t periods, uint16_t max){
+    if (Widget_Wave_Count >= WIDGET_MAX_TRACES) {
+        return WIDGET_INVALID;
+    }
+    uint8_t id = Widget_Add(WIDGET_TRACE, page, 2, column, width);
+    if (id != WIDGET_INVALID) {
+        if (max != 0) {
+            Widget_Table[id].max = max;
+        }
+        Widget_Table[id].wave = Widget_Wave_Count;
+        Waveform_Init(&Widget_Waves[Widget_Wave_Count++], page, page + 1, column, width, periods, 0, 0);
+    }
+    return id;
+}
+
+void Widget_Set_Value(uint8_t id, uint16_t value){
+    if (id >= Widget_Count || Widget_Table[id].value == value) {
+        return;
+    }
+    Widget_Table[id].value = value;
+    Widget_Table[id].dirty = 1;
+}
+
+void Widget_Set_Text(uint8_t id, const char* text){
+    if (id >= Widget_Count) {
+        return;
+    }
+    Widget_Table[id].text = text;
+    Widget_Table[id].dirty = 1;
+}
+
+void Widget_Invalidate(uint8_t id){
+    if (id >= Widget_Count) {
+        return;
+    }
+    Widget_Table[id].dirty = 1;
+    if (Widget_Table[id].type == WIDGET_TRACE) {
+        Waveform_Invalidate(&Widget_Waves[Widget_Table[id].wave]);
+    }
+}
+
+void Widget_Invalidate_All(void){
+    for (uint8_t id = 0; id < Widget_Count; id++) {
+        Widget_Invalidate(id);
+    }
+}
+
+// --- Drawing ---
+
+static void Widget_Fill(uint8_t page, uint8_t column, uint8_t data, uint8_t length){
+    while (length-- != 0) {
+        GLCD_WriteByte(page, column++, data);
+    }
+}
+
+// Text cell by cell inside the box, the rest of the box blanked
+static void Widget_Draw_Text(const Widget* w, const char* text){
+    uint8_t column = w->column;
+    uint8_t end = w->column + w->width;
+
+    for (; *text != '\0' && column + WIDGET_CHAR_WIDTH <= end; text++) {
+        GLCD_WriteChar(w->page, column, *text);
+        column += WIDGET_CHAR_WIDTH;
+    }
+    Widget_Fill(w->page, column, 0x00, end - column);
+}
+
+// Text right-aligned in the box, every page of it blanked left of the text
+static void Widget_Draw_Font_Text(const Widget* w, const char* text){
+    uint16_t width = Font_String_Width(w->font, text);
+    uint8_t x = w->column;
+
+    if (width < w->width) {
+        x += w->width - width;
+    }
+    for (uint8_t p = 0; p < w->pages; p++) {
+        Widget_Fill(w->page + p, w->column, 0x00, x - w->column);
+    }
+    Font_Draw_String(w->font, x, w->page * 8, text);
+}
+
+// Value scaled to 0..width columns, rounded
+static uint8_t Widget_Scale(const Widget* w, uint8_t width){
+    uint16_t value = (w->value > w->max) ? w->max : w->value;
+    return (uint8_t)(((uint32_t)value * width + w->max / 2) / w->max);
+}
+
+static void Widget_Draw_Bar(const Widget* w){
+    uint8_t filled = Widget_Scale(w, w->width);
+
+    // Every column written once with its final byte: drawing over it again
+    // would leave it dirty, and re-sent, even when it did not change
+    if (filled == w->width) {
+        filled--;
+    }
+    Widget_Fill(w->page, w->column, WIDGET_BAR_FILL, filled);
+    Widget_Fill(w->page, w->column + filled, WIDGET_BAR_EMPTY, w->width - 1 - filled);
+    // Closed right end so an empty bar still shows its length
+    GLCD_WriteByte(w->page, w->column + w->width - 1, WIDGET_BAR_END);
+}
+
+static void Widget_Draw_Trace(const Widget* w){
+    Waveform* wave = &Widget_Waves[w->wave];
+    Waveform_Draw(wave, Widget_Scale(w, Waveform_Period_Width(wave)));
+}
+
+uint8_t Widget_Render(void){
+    char buffer[FORMAT_MAX_LEN];
+    uint8_t drawn = 0;
+
+    for (uint8_t id = 0; id < Widget_Count; id++) {
+        Widget* w = &Widget_Table[id];
+        if (!w->dirty) {
+            continue;
+        }
+        w->dirty = 0;
+        drawn++;
+
+        switch (w->type) {
+            case WIDGET_LABEL:
+                Widget_Draw_Text(w, w->text);
+                break;
+            case WIDGET_NUMBER:
+                Format_Number16(buffer, w->value, w->digits, w->flags);
+                Widget_Draw_Text(w, buffer);
+                break;
+            case WIDGET_FONT_NUMBER:
+                Format_Number16(buffer, w->value, 0, w->flags);
+                Widget_Draw_Font_Text(w, buffer);
+                break;
+            case WIDGET_BAR:
+                Widget_Draw_Bar(w);
+                break;
+            case WIDGET_TRACE:
+                Widget_Draw_Trace(w);
+                break;
+        }
+    }
+    return drawn;
+}
@@ -0,0 +1,62 @@
+/*
+ * File:   Widget.h
+ * Author: Mostafa Eshra
+ *
+ * Description: Retained-mode widgets on top of the GLCD framebuffer. Each
+ *              widget keeps its box and value and is redrawn by
+ *              Widget_Render() only after its value actually changed.
+ */
+
+#ifndef WIDGET_H
+#define	WIDGET_H
+
+#include <stdint.h>
+#include "Font.h"
+
+// Maximum number of widgets on screen
+#define WIDGET_MAX_COUNT       8
+// Trace widgets each keep a Waveform (~50 bytes)
+#define WIDGET_MAX_TRACES      2
+
+#define WIDGET_INVALID         0xFF
+
+// Widget types
+#define WIDGET_LABEL           0   // Text, one page high
+#define WIDGET_NUMBER          1   // Fixed-width number (Format.h flags)
+#define WIDGET_BAR             2   // Horizontal bar, one page high
+#define WIDGET_TRACE           3   // Square wave (Waveform.h), two pages high
+#define WIDGET_FONT_NUMBER     4   // Number in a Font.h font, as many pages as it is high
+
+// Character cell width (5 glyph columns + 1 blank)
+#define WIDGET_CHAR_WIDTH      6
+
+// Every Widget_Add_* returns an id for the setters, or WIDGET_INVALID when
+// the table is full or the box does not fit on the display. Text is drawn
+// cell by cell exactly inside the box (no jump at the chip boundary).
+
+// The box is as wide as the initial text, the pointer is kept (not copied)
+uint8_t Widget_Add_Label(uint8_t page, uint8_t column, const char* text);
+// digits wide (plus '%' with FORMAT_PERCENT)
+uint8_t Widget_Add_Number(uint8_t page, uint8_t column, uint8_t digits, uint8_t flags);
+// Right-aligned in a box width columns wide, which must fit the widest
+// value; the font's top row is at the top of page
+uint8_t Widget_Add_Font_Number(uint8_t page, uint8_t column, uint8_t width, const Font* font, uint8_t flags);
+// value 0..max fills width columns
+uint8_t Widget_Add_Bar(uint8_t page, uint8_t column, uint8_t width, uint16_t max);
+// value 0..max is the high part of each of `periods` periods across width
+// columns, drawn on page and page + 1 (only changed columns are redrawn)
+uint8_t Widget_Add_Trace(uint8_t page, uint8_t column, uint8_t width, uint8_t periods, uint16_t max);
+
+// Marks the widget dirty only if the value differs from the shown one
+void Widget_Set_Value(uint8_t id, uint16_t value);
+// Labels: new text, must fit the box (longer text is clipped)
+void Widget_Set_Text(uint8_t id, const char* text);
+// Forces a redraw, e.g. after the screen was cleared
+void Widget_Invalidate(uint8_t id);
+void Widget_Invalidate_All(void);
+
+// Redraws the dirty widgets into the framebuffer and returns how many were
+// drawn; GLCD_Flush() then sends only the bytes that changed
+uint8_t Widget_Render(void);
+
+#endif	/* WIDGET_H */
@@ -0,0 +1,436 @@
+/*
+ * File:   Bench.c
+ * Author: Mostafa Eshra
+ *
+ * Description: Microbenchmarks of the GLCD, ADC and Timer primitives on the
+ *              host model (firmware built as for DISPLAY_VIEW 0, panel =
+ *              KS0108 model). Each primitive is called BENCH_CALLS times
+ *              with changing arguments. GLCD drawing only reaches the
+ *              framebuffer, so after each of those calls the frame is
+ *              flushed and the bench waits until the Timer2 queue ISR has
+ *              put it on the panel; that time and its bus transactions are
+ *              part of the primitive's cost.
+ *
+ * Per call: estimated CPU cycles of the call itself (Host_CPU_Cycles():
+ * model clock plus SRAM accesses and calls at their AVR cost), model
+ * microseconds until the panel shows the result, bus transactions (E
+ * strobes), busy-flag reads, register accesses, SRAM accesses, function
+ * calls and host wall time. The results go to a CSV; every model figure is compared with
+ * the baseline CSV and more than BENCH_TOLERANCE_PERCENT above it fails.
+ * Wall time is reported only, it depends on the machine.
+ *
+ * Usage: bench out.csv baseline.csv
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <avr/interrupt.h>
+#include "Host.h"
+#include "KS0108.h"
+#include "ADC.h"
+#include "GLCD.h"
+#include "Graphics.h"
+#include "Timer.h"
+
+#ifndef BENCH_CALLS
+#define BENCH_CALLS               1000
+#endif
+#define BENCH_TOLERANCE_PERCENT   2
+// Model time allowed per call (a clear screen takes ~67 ms), a hang fails the run
+#define BENCH_BUDGET_MS           250UL
+#define BENCH_MAX_CASES           32
+// Scheduler tick: Timer0 overflow at /64
+#define BENCH_TICK_CYCLES         (64UL * 256)
+
+// Model figures per call, in CSV column order
+enum {
+    BENCH_CYCLES,
+    BENCH_PANEL_US,
+    BENCH_BUS,
+    BENCH_BUSY,
+    BENCH_REG,
+    BENCH_MEM,
+    BENCH_FN_CALLS,
+    BENCH_FIGURES
+};
+
+static const char* const Bench_Columns[BENCH_FIGURES] = {
+    "cycles", "panel_us", "bus", "busy_reads", "reg_accesses", "mem_accesses", "calls"
+};
+
+typedef struct {
+    const char* name;
+    void (*setup)(void);            // NULL = nothing to set up
+    void (*call)(uint16_t i);
+    uint8_t show;                   // Drawing: flush and wait for the panel
+} Bench_Case;
+
+typedef struct {
+    double figure[BENCH_FIGURES];
+    double wall_ns;
+} Bench_Result;
+
+// --- Primitives ---
+static char Bench_Percent[101][5];
+static const char* const Bench_Strings[2] = { "PWM Duty:", "Duty PWM:" };
+
+static void Bench_ClearScreen(uint16_t i) {
+    (void)i;
+    GLCD_ClearScreen();
+}
+
+static void Bench_WriteChar(uint16_t i) {
+    // Column 60: the glyph straddles the two chips
+    GLCD_WriteChar(3, 60, 'A' + i % 26);
+}
+
+static void Bench_WriteString(uint16_t i) {
+    GLCD_WriteString(2, 2, Bench_Strings[i & 1]);
+}
+
+static void Bench_Setup_Percent(void) {
+    for (uint8_t p = 0; p <= 100; p++) {
+        snprintf(Bench_Percent[p], sizeof(Bench_Percent[p]), "%u%%", p);
+    }
+}
+
+static void Bench_Write_Per(uint16_t i) {
+    GLCD_Write_Per(Bench_Percent[i % 101]);
+}
+
+static void Bench_Draw_Signal(uint16_t i) {
+    GLCD_Draw_Signal((char)(i % 65));
+}
+
+static void Bench_int_to_string(uint16_t i) {
+    char buffer[16];
+    int_to_string((int32_t)(i * 2654435761UL), buffer);
+}
+
+static void Bench_Setup_ADC(void) {
+    init_ADC(ADC_CH6, ADC_REF_AREF, ADC_PRE_128);
+    Host_Set_ADC(ADC_CH6, 512);
+}
+
+static void Bench_ADC_read(uint16_t i) {
+    (void)i;
+    ADC_SC();
+    ADC_read();
+}
+
+static void Bench_Setup_Timer0(void) {
+    init_Timer0(TIMER0_MODE_FPWM, TIMER0_CS_PRE_64);
+}
+
+static void Bench_Timer0_SET_COMP_VAL(uint16_t i) {
+    Timer0_SET_COMP_VAL((char)i);
+}
+
+// One bus byte (a command, the chip being ready) before and after the
+// DIO_FAST_* macros: Old_GLCD_Command() is the DIO_Set_PIN_VALUE() version
+// (host/Bench_Old_Bus.c), GLCD_Command() today's. Neither is in GLCD.h.
+// They drive the bus behind the GLCD_Out_* bookkeeping, so they run after
+// the drawing cases.
+void GLCD_SelectChip(uint8_t chip);
+void GLCD_Command(uint8_t cmd);
+void Old_GLCD_Command(uint8_t cmd);
+
+static void Bench_Setup_Bus(void) {
+    GLCD_SelectChip(GLCD_CHIP_1);
+}
+
+static void Bench_Old_Bus_Byte(uint16_t i) {
+    (void)i;
+    Old_GLCD_Command(GLCD_DISPLAY_ON);
+}
+
+static void Bench_Bus_Byte(uint16_t i) {
+    (void)i;
+    GLCD_Command(GLCD_DISPLAY_ON);
+}
+
+// Graphics.c primitives and their per-pixel references (host/Bench_Gfx.c),
+// framebuffer only. GFX_INVERT, so every call changes the bytes it touches.
+// The lines are axis-aligned: a sloped Gfx_Line() is the same walk as
+// Naive_Line().
+void Naive_Fill_Rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t color);
+void Naive_Rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t color);
+void Naive_Line(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t color);
+void Naive_Bitmap(uint8_t x, uint8_t y, const uint8_t* bitmap, uint8_t width, uint8_t height, uint8_t color);
+
+// 32 x 16, two rows of 32 column bytes
+static const uint8_t Bench_Bitmap[2 * 32] = {
+    0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA,
+    0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA,
+    0xFF, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0xFF, 0xFF, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0xFF,
+    0xFF, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0xFF, 0xFF, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0xFF,
+};
+
+static void Bench_Gfx_HLine(uint16_t i) {
+    Gfx_Line(0, 13 + (i & 7), 127, 13 + (i & 7), GFX_INVERT);
+}
+
+static void Bench_Naive_HLine(uint16_t i) {
+    Naive_Line(0, 13 + (i & 7), 127, 13 + (i & 7), GFX_INVERT);
+}
+
+static void Bench_Gfx_VLine(uint16_t i) {
+    Gfx_Line(40 + (i & 7), 0, 40 + (i & 7), 63, GFX_INVERT);
+}
+
+static void Bench_Naive_VLine(uint16_t i) {
+    Naive_Line(40 + (i & 7), 0, 40 + (i & 7), 63, GFX_INVERT);
+}
+
+static void Bench_Gfx_Fill_Rect(uint16_t i) {
+    Gfx_Fill_Rect(10, 3 + (i & 7), 100, 40, GFX_INVERT);
+}
+
+static void Bench_Naive_Fill_Rect(uint16_t i) {
+    Naive_Fill_Rect(10, 3 + (i & 7), 100, 40, GFX_INVERT);
+}
+
+static void Bench_Gfx_Rect(uint16_t i) {
+    Gfx_Rect(10, 3 + (i & 7), 100, 40, GFX_INVERT);
+}
+
+static void Bench_Naive_Rect(uint16_t i) {
+    Naive_Rect(10, 3 + (i & 7), 100, 40, GFX_INVERT);
+}
+
+static void Bench_Gfx_Bitmap(uint16_t i) {
+    Gfx_Bitmap(20, 5 + (i & 7), Bench_Bitmap, 32, 16, GFX_INVERT);
+}
+
+static void Bench_Naive_Bitmap(uint16_t i) {
+    Naive_Bitmap(20, 5 + (i & 7), Bench_Bitmap, 32, 16, GFX_INVERT);
+}
+
+static const Bench_Case Bench_Cases[] = {
+    { "GLCD_ClearScreen",      NULL,                Bench_ClearScreen,         1 },
+    { "GLCD_WriteChar",        NULL,                Bench_WriteChar,           1 },
+    { "GLCD_WriteString",      NULL,                Bench_WriteString,         1 },
+    { "GLCD_Write_Per",        Bench_Setup_Percent, Bench_Write_Per,           1 },
+    { "GLCD_Draw_Signal",      NULL,                Bench_Draw_Signal,         1 },
+    { "int_to_string",         NULL,                Bench_int_to_string,       0 },
+    { "ADC_SC+ADC_read",       Bench_Setup_ADC,     Bench_ADC_read,            0 },
+    { "Timer0_SET_COMP_VAL",   Bench_Setup_Timer0,  Bench_Timer0_SET_COMP_VAL, 0 },
+    { "bus byte DIO_Set_PIN",  Bench_Setup_Bus,     Bench_Old_Bus_Byte,        0 },
+    { "bus byte DIO_FAST",     Bench_Setup_Bus,     Bench_Bus_Byte,            0 },
+    { "Gfx_Line horizontal",   NULL,                Bench_Gfx_HLine,           0 },
+    { "naive horizontal",      NULL,                Bench_Naive_HLine,         0 },
+    { "Gfx_Line vertical",     NULL,                Bench_Gfx_VLine,           0 },
+    { "naive vertical",        NULL,                Bench_Naive_VLine,         0 },
+    { "Gfx_Fill_Rect",         NULL,                Bench_Gfx_Fill_Rect,       0 },
+    { "naive Fill_Rect",       NULL,                Bench_Naive_Fill_Rect,     0 },
+    { "Gfx_Rect",              NULL,                Bench_Gfx_Rect,            0 },
+    { "naive Rect",            NULL,                Bench_Naive_Rect,          0 },
+    { "Gfx_Bitmap",            NULL,                Bench_Gfx_Bitmap,          0 },
+    { "naive Bitmap",          NULL,                Bench_Naive_Bitmap,        0 },
+};
+#define BENCH_CASES  (sizeof(Bench_Cases) / sizeof(Bench_Cases[0]))
+
+// --- Running ---
+static const Bench_Case* Bench_Current;
+static Bench_Result Bench_Results[BENCH_CASES];
+
+static double Bench_Now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+static void Bench_Start(void) {
+    GLCD_Init();
+    sei();
+}
+
+// Until the panel shows the framebuffer. A flush that did not fit the
+// queue is retried one scheduler tick later, as the display tasks do. The
+// queue ISR switches itself off once everything is sent: that is checked on
+// the model, so the waiting adds no firmware work to the figures.
+static void Bench_Show(void) {
+    while (!GLCD_Flush()) {
+        Host_Idle(BENCH_TICK_CYCLES);
+    }
+    while (Host_IO[HOST_TIMSK] & (1 << OCIE2)) {
+        Host_Idle(16);
+    }
+}
+
+static void Bench_Run_Case(void) {
+    const Bench_Case* c = Bench_Current;
+    Bench_Result* r = &Bench_Results[c - Bench_Cases];
+    Host_Counters start = Host_Count;
+    uint64_t call_cycles = 0;
+
+    for (uint16_t i = 0; i < BENCH_CALLS; i++) {
+        uint64_t before = Host_CPU_Cycles();
+        double wall = Bench_Now_ns();
+
+        c->call(i);
+        r->wall_ns += Bench_Now_ns() - wall;
+        call_cycles += Host_CPU_Cycles() - before;
+        if (c->show) {
+            Bench_Show();
+        }
+    }
+
+    r->figure[BENCH_CYCLES] = (double)call_cycles / BENCH_CALLS;
+    r->figure[BENCH_PANEL_US] = (double)(Host_Count.cycles - start.cycles) / BENCH_CALLS / (F_CPU / 1000000UL);
+    r->figure[BENCH_BUS] = (double)(Host_Count.e_strobes - start.e_strobes) / BENCH_CALLS;
+    r->figure[BENCH_BUSY] = (double)(Host_Count.busy_reads - start.busy_reads) / BENCH_CALLS;
+    r->figure[BENCH_REG] = (double)(Host_Count.reg_reads + Host_Count.reg_writes
+                                    - start.reg_reads - start.reg_writes) / BENCH_CALLS;
+    r->figure[BENCH_MEM] = (double)(Host_Count.mem_accesses - start.mem_accesses) / BENCH_CALLS;
+    r->figure[BENCH_FN_CALLS] = (double)(Host_Count.calls - start.calls) / BENCH_CALLS;
+    r->wall_ns /= BENCH_CALLS;
+}
+
+static void Bench_Setup_Current(void) {
+    if (Bench_Current->setup) {
+        Bench_Current->setup();
+    }
+}
+
+// --- CSV ---
+static int Bench_Write_CSV(const char* path) {
+    FILE* file = fopen(path, "w");
+
+    if (file == NULL) {
+        perror(path);
+        return 0;
+    }
+    fprintf(file, "primitive,calls");
+    for (uint8_t f = 0; f < BENCH_FIGURES; f++) {
+        fprintf(file, ",%s", Bench_Columns[f]);
+    }
+    fprintf(file, ",wall_ns\n");
+    for (uint8_t i = 0; i < BENCH_CASES; i++) {
+        fprintf(file, "%s,%u", Bench_Cases[i].name, BENCH_CALLS);
+        for (uint8_t f = 0; f < BENCH_FIGURES; f++) {
+            fprintf(file, ",%.2f", Bench_Results[i].figure[f]);
+        }
+        fprintf(file, ",%.0f\n", Bench_Results[i].wall_ns);
+    }
+    fclose(file);
+    return 1;
+}
+
+typedef struct {
+    char name[32];
+    double figure[BENCH_FIGURES];
+} Bench_Baseline;
+
+// Rows read, or -1 if the file cannot be opened
+static int Bench_Read_Baseline(const char* path, Bench_Baseline* rows, int max_rows) {
+    FILE* file = fopen(path, "r");
+    char line[256];
+    int count = 0;
+
+    if (file == NULL) {
+        return -1;
+    }
+    // First line is the header
+    if (fgets(line, sizeof(line), file) != NULL) {
+        while (count < max_rows && fgets(line, sizeof(line), file) != NULL) {
+            Bench_Baseline* row = &rows[count];
+            unsigned calls;
+            int used;
+            if (sscanf(line, "%31[^,],%u%n", row->name, &calls, &used) != 2) {
+                continue;
+            }
+            // The figures in column order, each after a comma
+            char* field = &line[used];
+            uint8_t f;
+            for (f = 0; f < BENCH_FIGURES && *field == ','; f++) {
+                row->figure[f] = strtod(field + 1, &field);
+            }
+            if (f == BENCH_FIGURES) {
+                count++;
+            }
+        }
+    }
+    fclose(file);
+    return count;
+}
+
+int main(int argc, char** argv) {
+    Bench_Baseline baseline[BENCH_MAX_CASES];
+    int baseline_rows;
+    unsigned regressions = 0;
+    uint64_t budget;
+
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s out.csv baseline.csv\n", argv[0]);
+        return 2;
+    }
+
+    Host_Reset();
+    KS0108_Init();
+    Host_Run(Bench_Start, (uint64_t)BENCH_BUDGET_MS * (F_CPU / 1000UL));
+    budget = (uint64_t)BENCH_CALLS * BENCH_BUDGET_MS * (F_CPU / 1000UL);
+
+    for (uint8_t i = 0; i < BENCH_CASES; i++) {
+        Bench_Current = &Bench_Cases[i];
+        if (Host_Run(Bench_Setup_Current, budget) || Host_Run(Bench_Run_Case, budget)) {
+            printf("%s did not finish within %lu ms of model time per call\n", Bench_Cases[i].name, BENCH_BUDGET_MS);
+            return 1;
+        }
+    }
+    if (!Bench_Write_CSV(argv[1])) {
+        return 2;
+    }
+
+    baseline_rows = Bench_Read_Baseline(argv[2], baseline, BENCH_MAX_CASES);
+    if (baseline_rows < 0) {
+        printf("no baseline %s (make host-bench-baseline writes one)\n", argv[2]);
+    }
+
+    printf("%-20s %9s %9s %7s %6s %8s %8s %7s %8s\n", "per call", "cycles", "panel us", "bus",
+           "busy", "reg", "mem", "calls", "wall ns");
+    for (uint8_t i = 0; i < BENCH_CASES; i++) {
+        const Bench_Result* r = &Bench_Results[i];
+        const Bench_Baseline* base = NULL;
+
+        printf("%-20s %9.1f %9.1f %7.1f %6.1f %8.1f %8.1f %7.1f %8.0f\n", Bench_Cases[i].name,
+               r->figure[BENCH_CYCLES], r->figure[BENCH_PANEL_US], r->figure[BENCH_BUS],
+               r->figure[BENCH_BUSY], r->figure[BENCH_REG], r->figure[BENCH_MEM],
+               r->figure[BENCH_FN_CALLS], r->wall_ns);
+
+        for (int b = 0; b < baseline_rows; b++) {
+            if (strcmp(baseline[b].name, Bench_Cases[i].name) == 0) {
+                base = &baseline[b];
+            }
+        }
+        if (base == NULL) {
+            if (baseline_rows >= 0) {
+                printf("  not in the baseline\n");
+                regressions++;
+            }
+            continue;
+        }
+        for (uint8_t f = 0; f < BENCH_FIGURES; f++) {
+            double limit = base->figure[f] * (100 + BENCH_TOLERANCE_PERCENT) / 100.0;
+            // Rounded as in the CSV, so a rerun of the baseline passes
+            double now = (double)(long long)(r->figure[f] * 100 + 0.5) / 100;
+            if (now > limit + 0.005) {
+                printf("  REGRESSION %s: %.2f, baseline %.2f (+%.1f%%)\n", Bench_Columns[f], now,
+                       base->figure[f], base->figure[f] > 0 ? (now / base->figure[f] - 1) * 100 : 100.0);
+                regressions++;
+            }
+        }
+    }
+    printf("CSV: %s\n", argv[1]);
+    if (baseline_rows < 0) {
+        return 1;
+    }
+    if (regressions != 0) {
+        printf("%u regressions against %s (over %u%%)\n", regressions, argv[2], BENCH_TOLERANCE_PERCENT);
+        return 1;
+    }
+    printf("no regressions against %s (tolerance %u%%)\n", argv[2], BENCH_TOLERANCE_PERCENT);
+    return 0;
+}
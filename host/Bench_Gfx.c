@@ -0,0 +1,73 @@
+/*
+ * File:   Bench_Gfx.c
+ * Author: Mostafa Eshra
+ *
+ * Description: Per-pixel references for the Graphics.c primitives: every
+ *              pixel through Gfx_Pixel(), so every byte is read, merged and
+ *              written once per pixel. Built like the firmware, so
+ *              host/Bench.c can cost each primitive against its reference
+ *              on the model. Naive_Line is the Bresenham walk Gfx_Line()
+ *              does for sloped lines, used for every line: only horizontal
+ *              and vertical lines differ from Gfx_Line().
+ */
+
+#include <stdint.h>
+#include "Graphics.h"
+
+void Naive_Fill_Rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t color);
+void Naive_Rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t color);
+void Naive_Line(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t color);
+void Naive_Bitmap(uint8_t x, uint8_t y, const uint8_t* bitmap, uint8_t width, uint8_t height, uint8_t color);
+
+void Naive_Fill_Rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t color) {
+    for (uint8_t j = 0; j < height; j++) {
+        for (uint8_t i = 0; i < width; i++) {
+            Gfx_Pixel(x + i, y + j, color);
+        }
+    }
+}
+
+void Naive_Rect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t color) {
+    for (uint8_t i = 0; i < width; i++) {
+        Gfx_Pixel(x + i, y, color);
+        Gfx_Pixel(x + i, y + height - 1, color);
+    }
+    for (uint8_t j = 1; j < height - 1; j++) {
+        Gfx_Pixel(x, y + j, color);
+        Gfx_Pixel(x + width - 1, y + j, color);
+    }
+}
+
+void Naive_Line(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t color) {
+    int16_t dx = (x1 > x0) ? (x1 - x0) : (x0 - x1);
+    int16_t dy = (y1 > y0) ? (y0 - y1) : (y1 - y0);    // -|dy|
+    int8_t sx = (x0 < x1) ? 1 : -1;
+    int8_t sy = (y0 < y1) ? 1 : -1;
+    int16_t err = dx + dy;
+
+    for (;;) {
+        Gfx_Pixel(x0, y0, color);
+        if (x0 == x1 && y0 == y1) {
+            break;
+        }
+        int16_t e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+void Naive_Bitmap(uint8_t x, uint8_t y, const uint8_t* bitmap, uint8_t width, uint8_t height, uint8_t color) {
+    for (uint8_t j = 0; j < height; j++) {
+        for (uint8_t i = 0; i < width; i++) {
+            if (bitmap[(uint16_t)(j >> 3) * width + i] & (1 << (j & 7))) {
+                Gfx_Pixel(x + i, y + j, color);
+            }
+        }
+    }
+}
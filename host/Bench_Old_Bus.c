@@ -0,0 +1,62 @@
+/*
+ * File:   Bench_Old_Bus.c
+ * Author: Mostafa Eshra
+ *
+ * Description: GLCD_BusyWait() and GLCD_Command() as they were before the
+ *              DIO_FAST_* macros (every pin through DIO_Set_PIN_VALUE() and
+ *              friends), copied unchanged under Old_ names. Built like the
+ *              firmware, so host/Bench.c can cost one bus byte through the
+ *              old path and through today's GLCD_Command() on the model.
+ */
+
+#include "GLCD.h"
+#include "DIO.h"
+#include <util/delay.h>
+#include <avr/io.h>
+#include <stdint.h>
+
+void Old_GLCD_BusyWait(void);
+void Old_GLCD_Command(uint8_t cmd);
+
+// Waits for the controller chip to finish its current operation
+void Old_GLCD_BusyWait(void) {
+    char busy_flag; // Variable to hold the result of the DIO_Read_PIN function
+
+    // 1. Set GLCD data port to input (Use GLCD_DATA_PORT for direction setting)
+    DIO_Set_PORT_DIR(GLCD_DATA_PORT, 0x00);
+    
+    // 2. Control sequence for reading busy flag
+    DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_RW_PIN, HIGH); // Read mode
+    DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_RS_PIN, LOW);  // Command mode
+    
+    // 3. Loop until Busy Flag (DB7) is LOW (not busy)
+    do {
+        // Toggle Enable pin to read the status
+        DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_E_PIN, HIGH);
+        _delay_us(1); 
+        DIO_Read_PIN(GLCD_DATA_PORT, 7, &busy_flag); // Read the value of DB7
+        DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_E_PIN, LOW);
+        _delay_us(1); 
+    } while (busy_flag == HIGH); // Repeat if DB7 (Busy Flag) is HIGH
+    
+    // 4. Set GLCD data port back to output for writing data
+    DIO_Set_PORT_DIR(GLCD_DATA_PORT, 0xFF);
+    
+    // 5. Reset control pins
+    DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_RW_PIN, LOW); // Write mode
+}
+
+// Sends a command byte to the currently selected chip
+void Old_GLCD_Command(uint8_t cmd) {
+    Old_GLCD_BusyWait(); // Wait until the chip is ready
+
+    // 1. Control signals: RS=LOW (Command), RW=LOW (Write)
+    DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_RS_PIN, LOW); 
+    DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_RW_PIN, LOW); 
+    
+    // 2. Put data on bus and pulse Enable
+    DIO_Set_PORT_VALUE(GLCD_DATA_PORT, cmd);
+    DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_E_PIN, HIGH);
+    _delay_us(1); 
+    DIO_Set_PIN_VALUE(GLCD_CONTROL_PORT, GLCD_E_PIN, LOW);
+}
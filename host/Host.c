@@ -0,0 +1,572 @@
+/*
+ * File:   Host.c
+ * Author: Mostafa Eshra
+ *
+ * Built without instrumentation: only the firmware objects call the
+ * __asan_* hooks below.
+ */
+
+#include "Host.h"
+#include <setjmp.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <avr/io.h>
+#include "GLCD.h"
+
+uint8_t Host_IO[HOST_IO_SIZE];
+Host_Counters Host_Count;
+
+// --- Vectors ---
+// Weak, so a build without some ISR still links (an enabled interrupt with
+// no ISR resets the target: reported here instead)
+#define HOST_VECTOR(name)  void name(void) __attribute__((weak))
+HOST_VECTOR(TIMER2_COMP_vect);
+HOST_VECTOR(TIMER2_OVF_vect);
+HOST_VECTOR(TIMER1_CAPT_vect);
+HOST_VECTOR(TIMER1_COMPA_vect);
+HOST_VECTOR(TIMER1_COMPB_vect);
+HOST_VECTOR(TIMER1_OVF_vect);
+HOST_VECTOR(TIMER0_COMP_vect);
+HOST_VECTOR(TIMER0_OVF_vect);
+HOST_VECTOR(ADC_vect);
+
+typedef struct {
+    void (*isr)(void);
+    const char* name;
+    uint8_t flag_reg;
+    uint8_t flag;
+    uint8_t enable_reg;
+    uint8_t enable;
+} Host_Vector;
+
+// ATmega32 priority order (lowest vector number first)
+static const Host_Vector Host_Vectors[] = {
+    { TIMER2_COMP_vect,  "TIMER2_COMP",  HOST_TIFR,   OCF2,  HOST_TIMSK,  OCIE2 },
+    { TIMER2_OVF_vect,   "TIMER2_OVF",   HOST_TIFR,   TOV2,  HOST_TIMSK,  TOIE2 },
+    { TIMER1_CAPT_vect,  "TIMER1_CAPT",  HOST_TIFR,   ICF1,  HOST_TIMSK,  TICIE1 },
+    { TIMER1_COMPA_vect, "TIMER1_COMPA", HOST_TIFR,   OCF1A, HOST_TIMSK,  OCIE1A },
+    { TIMER1_COMPB_vect, "TIMER1_COMPB", HOST_TIFR,   OCF1B, HOST_TIMSK,  OCIE1B },
+    { TIMER1_OVF_vect,   "TIMER1_OVF",   HOST_TIFR,   TOV1,  HOST_TIMSK,  TOIE1 },
+    { TIMER0_COMP_vect,  "TIMER0_COMP",  HOST_TIFR,   OCF0,  HOST_TIMSK,  OCIE0 },
+    { TIMER0_OVF_vect,   "TIMER0_OVF",   HOST_TIFR,   TOV0,  HOST_TIMSK,  TOIE0 },
+    { ADC_vect,          "ADC",          HOST_ADCSRA, ADIF,  HOST_ADCSRA, ADIE },
+};
+#define HOST_VECTOR_COUNT  (sizeof(Host_Vectors) / sizeof(Host_Vectors[0]))
+
+// --- State ---
+typedef struct {
+    uint16_t prescale;      // CPU cycles since the last count
+    uint8_t down;           // Dual slope modes: counting down
+    uint16_t ocr_a;         // PWM modes: compare values latched from OCRx
+    uint16_t ocr_b;
+} Host_Timer;
+
+static Host_Timer Host_Timer0, Host_Timer1, Host_Timer2;
+
+// CS bits -> CPU cycles per count, 0 = stopped (or external clock: not modeled)
+static const uint16_t Host_Prescale_01[8] = { 0, 1, 8, 64, 256, 1024, 0, 0 };
+static const uint16_t Host_Prescale_2[8] = { 0, 1, 8, 32, 64, 128, 256, 1024 };
+
+static uint32_t Host_ADC_Left;      // CPU cycles to the end of the conversion, 0 = idle
+static uint8_t Host_ADC_Channel;    // MUX latched at the start
+static uint16_t Host_ADC_Input[8];
+static uint16_t (*Host_ADC_Source_Fn)(uint8_t channel, uint64_t cycles);
+
+static uint8_t Host_Pin_Level[4];   // Driven from outside, PIND/PINC/PINB/PINA order
+static Host_Port_Hook Host_Hook;
+
+// A store is seen by its hook before it happens: the old bytes are kept
+// here and its effect is applied at the next hook (Host_Commit)
+static uint8_t Host_Pending_Addr;
+static uint8_t Host_Pending_Size;
+static uint8_t Host_Pending_Old[16];
+
+// The registers as the firmware last saw them. The sanitizer drops the
+// store check of a read-modify-write through a pointer (*PORTx |= ...,
+// as in DIO.c) because the load was checked: such a store has no hook and
+// only shows up as a changed byte here (Host_Catch_Stores). A store that
+// leaves the value as it was is missed.
+static uint8_t Host_IO_Seen[HOST_IO_SIZE];
+
+static uint8_t Host_ISR_Depth;
+static uint8_t Host_Stop_Armed;
+static uint64_t Host_Stop_At;
+static jmp_buf Host_Stop_Jump;
+
+static void Host_Advance(uint64_t cycles);
+
+// --- ADC ---
+static void Host_ADC_Start(void) {
+    static const uint8_t divider[8] = { 2, 2, 4, 8, 16, 32, 64, 128 };
+
+    Host_ADC_Channel = Host_IO[HOST_ADMUX] & 0x1F;
+    Host_ADC_Left = 13UL * divider[Host_IO[HOST_ADCSRA] & 0x07];
+    Host_IO[HOST_ADCSRA] |= (1 << ADSC);
+}
+
+static void Host_ADC_Done(void) {
+    uint16_t code = 0;
+
+    // Single-ended channels only; differential and band gap read 0
+    if (Host_ADC_Channel < 8) {
+        code = Host_ADC_Source_Fn ? Host_ADC_Source_Fn(Host_ADC_Channel, Host_Count.cycles)
+                                  : Host_ADC_Input[Host_ADC_Channel];
+        code &= 0x3FF;
+    }
+    if (Host_IO[HOST_ADMUX] & (1 << ADLAR)) {
+        code <<= 6;
+    }
+    Host_IO[HOST_ADCL] = (uint8_t)code;
+    Host_IO[HOST_ADCL + 1] = (uint8_t)(code >> 8);
+    Host_IO[HOST_ADCSRA] |= (1 << ADIF);
+
+    uint8_t adcsra = Host_IO[HOST_ADCSRA];
+    if ((adcsra & (1 << ADATE)) && (Host_IO[HOST_SFIOR] >> ADTS0) == 0) {
+        Host_ADC_Start();   // Free running
+    } else {
+        Host_IO[HOST_ADCSRA] &= ~(1 << ADSC);
+    }
+}
+
+static void Host_ADC_Write(uint8_t old, uint8_t val) {
+    // ADIF is cleared by writing a one, ADSC cannot be cleared by software
+    uint8_t reg = (val & ~((1 << ADIF) | (1 << ADSC))) | (old & ((1 << ADIF) | (1 << ADSC)));
+    if (val & (1 << ADIF)) {
+        reg &= ~(1 << ADIF);
+    }
+    if (!(reg & (1 << ADEN))) {
+        Host_ADC_Left = 0;
+        reg &= ~(1 << ADSC);
+    }
+    Host_IO[HOST_ADCSRA] = reg;
+    if ((val & (1 << ADSC)) && (reg & (1 << ADEN)) && Host_ADC_Left == 0) {
+        Host_ADC_Start();
+    }
+}
+
+// Auto trigger on the rising edge of the flag ADTS selects
+static void Host_ADC_Trigger(uint8_t tifr_mask) {
+    static const uint8_t source[8] = {
+        0, 0, 0, (1 << OCF0), (1 << TOV0), (1 << OCF1B), (1 << TOV1), (1 << ICF1)
+    };
+    uint8_t adcsra = Host_IO[HOST_ADCSRA];
+
+    if ((adcsra & (1 << ADEN)) && (adcsra & (1 << ADATE)) && Host_ADC_Left == 0
+            && (source[Host_IO[HOST_SFIOR] >> ADTS0] & tifr_mask)) {
+        Host_ADC_Start();
+    }
+}
+
+// --- Timers ---
+static void Host_Flag(uint8_t bit) {
+    uint8_t mask = (1 << bit);
+
+    if (!(Host_IO[HOST_TIFR] & mask)) {
+        Host_IO[HOST_TIFR] |= mask;
+        Host_ADC_Trigger(mask);
+    }
+}
+
+// Timer0 and Timer2: same counter, different prescaler table and flags
+static void Host_Timer8_Step(Host_Timer* t, uint8_t tccr_addr, uint8_t tcnt_addr, uint8_t ocr_addr,
+                             const uint16_t* prescale, uint8_t tov, uint8_t ocf) {
+    uint8_t tccr = Host_IO[tccr_addr];
+    uint16_t divider = prescale[tccr & 0x07];
+
+    if (divider == 0 || ++t->prescale < divider) {
+        return;
+    }
+    t->prescale = 0;
+
+    uint8_t mode = (((tccr >> WGM01) & 1) << 1) | ((tccr >> WGM00) & 1);
+    uint8_t count = Host_IO[tcnt_addr];
+    uint8_t pwm = (mode == 1 || mode == 3);
+    uint8_t ocr = pwm ? (uint8_t)t->ocr_a : Host_IO[ocr_addr];
+
+    if (mode == 1) {
+        // Phase correct: OCR latched at TOP, overflow at BOTTOM
+        if (!t->down) {
+            if (++count == 0xFF) {
+                t->down = 1;
+                t->ocr_a = Host_IO[ocr_addr];
+            }
+        } else if (--count == 0) {
+            t->down = 0;
+            Host_Flag(tov);
+        }
+    } else if (mode == 2 && count == ocr) {
+        count = 0;      // CTC
+    } else if (count == 0xFF) {
+        count = 0;
+        Host_Flag(tov);
+        t->ocr_a = Host_IO[ocr_addr];
+    } else {
+        count++;
+    }
+    Host_IO[tcnt_addr] = count;
+    if (count == ocr) {
+        Host_Flag(ocf);
+    }
+}
+
+static uint16_t Host_IO16(uint8_t addr) {
+    return Host_IO[addr] | (Host_IO[addr + 1] << 8);
+}
+
+static void Host_Timer1_Step(void) {
+    Host_Timer* t = &Host_Timer1;
+    uint8_t tccr1b = Host_IO[HOST_TCCR1B];
+    uint16_t divider = Host_Prescale_01[tccr1b & 0x07];
+
+    if (divider == 0 || ++t->prescale < divider) {
+        return;
+    }
+    t->prescale = 0;
+
+    uint8_t mode = (((tccr1b >> WGM12) & 0x03) << 2) | (Host_IO[HOST_TCCR1A] & 0x03);
+    uint8_t dual = (mode >= 1 && mode <= 3) || (mode >= 8 && mode <= 11);
+    uint8_t pwm = !(mode == 0 || mode == 4 || mode == 12);
+    uint16_t ocr_a = pwm ? t->ocr_a : Host_IO16(HOST_OCR1A);
+    uint16_t ocr_b = pwm ? t->ocr_b : Host_IO16(HOST_OCR1B);
+    uint16_t top;
+
+    switch (mode) {
+        case 1: case 5: top = 0x00FF; break;
+        case 2: case 6: top = 0x01FF; break;
+        case 3: case 7: top = 0x03FF; break;
+        case 4: case 9: case 11: case 15: top = ocr_a; break;
+        case 8: case 10: case 12: case 14: top = Host_IO16(HOST_ICR1); break;
+        default: top = 0xFFFF; break;
+    }
+
+    uint16_t count = Host_IO16(HOST_TCNT1);
+    uint8_t at_top = 0;
+
+    if (dual) {
+        if (!t->down) {
+            if (++count >= top) {
+                t->down = 1;
+                at_top = 1;
+                t->ocr_a = Host_IO16(HOST_OCR1A);
+                t->ocr_b = Host_IO16(HOST_OCR1B);
+            }
+        } else if (--count == 0) {
+            t->down = 0;
+            Host_Flag(TOV1);
+        }
+    } else if (count == top) {
+        at_top = 1;
+        // Normal and CTC modes overflow at MAX only
+        if (pwm || top == 0xFFFF) {
+            Host_Flag(TOV1);
+        }
+        count = 0;
+        t->ocr_a = Host_IO16(HOST_OCR1A);
+        t->ocr_b = Host_IO16(HOST_OCR1B);
+    } else {
+        count++;
+    }
+    Host_IO[HOST_TCNT1] = (uint8_t)count;
+    Host_IO[HOST_TCNT1 + 1] = (uint8_t)(count >> 8);
+
+    if (at_top && (mode == 8 || mode == 10 || mode == 12 || mode == 14)) {
+        Host_Flag(ICF1);
+    }
+    if (count == ocr_a) {
+        Host_Flag(OCF1A);
+    }
+    if (count == ocr_b) {
+        Host_Flag(OCF1B);
+    }
+}
+
+// --- Clock and interrupts ---
+static const Host_Vector* Host_Pending_Vector(void) {
+    for (uint8_t i = 0; i < HOST_VECTOR_COUNT; i++) {
+        const Host_Vector* v = &Host_Vectors[i];
+        if ((Host_IO[v->flag_reg] & (1 << v->flag)) && (Host_IO[v->enable_reg] & (1 << v->enable))) {
+            return v;
+        }
+    }
+    return NULL;
+}
+
+static void Host_Commit_Stores(void);
+static void Host_Catch_Stores(void);
+
+// Control goes back to the firmware
+static void Host_Leave(void) {
+    memcpy(Host_IO_Seen, Host_IO, HOST_IO_SIZE);
+}
+
+static void Host_Dispatch(void) {
+    while (Host_IO[HOST_SREG] & (1 << SREG_I)) {
+        const Host_Vector* v = Host_Pending_Vector();
+        if (v == NULL) {
+            return;
+        }
+        // Flag cleared by the hardware on entry (ADIF too), I off inside
+        Host_IO[v->flag_reg] &= ~(1 << v->flag);
+        if (v->isr == NULL) {
+            fprintf(stderr, "host: %s enabled with no ISR (resets the target), ignored\n", v->name);
+            continue;
+        }
+        Host_IO[HOST_SREG] &= ~(1 << SREG_I);
+        Host_ISR_Depth++;
+        Host_Count.interrupts++;
+        Host_Advance(HOST_ISR_CYCLES / 2);
+        Host_Leave();
+        v->isr();
+        Host_Commit_Stores();
+        Host_Catch_Stores();
+        Host_Advance(HOST_ISR_CYCLES / 2);
+        Host_ISR_Depth--;
+        Host_IO[HOST_SREG] |= (1 << SREG_I);
+    }
+}
+
+static void Host_Advance(uint64_t cycles) {
+    while (cycles-- > 0) {
+        Host_Count.cycles++;
+        Host_Timer8_Step(&Host_Timer0, HOST_TCCR0, HOST_TCNT0, HOST_OCR0, Host_Prescale_01, TOV0, OCF0);
+        Host_Timer1_Step();
+        Host_Timer8_Step(&Host_Timer2, HOST_TCCR2, HOST_TCNT2, HOST_OCR2, Host_Prescale_2, TOV2, OCF2);
+        if (Host_ADC_Left != 0 && --Host_ADC_Left == 0) {
+            Host_ADC_Done();
+        }
+        if (Host_Stop_Armed && Host_Count.cycles >= Host_Stop_At) {
+            Host_Stop_Armed = 0;
+            longjmp(Host_Stop_Jump, 1);
+        }
+        Host_Dispatch();
+    }
+}
+
+// --- Register writes ---
+static void Host_Update_Pins(uint8_t pin) {
+    uint8_t ddr = Host_IO[HOST_DDR(pin)];
+    Host_IO[pin] = (Host_IO[HOST_PORT(pin)] & ddr) | (Host_Pin_Level[(pin - HOST_PIND) / 3] & ~ddr);
+    Host_IO_Seen[pin] = Host_IO[pin];   // Never a firmware store
+}
+
+// Bus transactions and busy flag polls, from the GLCD control pins
+static void Host_Bus_Probe(uint8_t addr, uint8_t old, uint8_t val) {
+    if (addr != _SFR_IO_ADDR(GLCD_CONTROL_PORT_REG)) {
+        return;
+    }
+    if ((val & ~old) & (1 << GLCD_E_PIN)) {
+        Host_Count.e_strobes++;
+        if ((val & (1 << GLCD_RW_PIN)) && !(val & (1 << GLCD_RS_PIN))) {
+            Host_Count.busy_reads++;
+        }
+    }
+}
+
+static void Host_Write(uint8_t addr, uint8_t old, uint8_t val) {
+    switch (addr) {
+        case HOST_TIFR:
+            Host_IO[addr] = old & ~val;     // Flags clear by writing a one
+            break;
+        case HOST_ADCSRA:
+            Host_ADC_Write(old, val);
+            break;
+        case HOST_PINA: case HOST_PINB: case HOST_PINC: case HOST_PIND:
+        case HOST_ADCL: case HOST_ADCL + 1:
+            Host_IO[addr] = old;            // Read only
+            break;
+        default:
+            if (addr >= HOST_PIND && addr <= HOST_PORT(HOST_PINA)) {
+                Host_Update_Pins(HOST_PIND + (addr - HOST_PIND) / 3 * 3);
+                Host_Bus_Probe(addr, old, val);
+                if (Host_Hook) {
+                    Host_Hook(addr, old, val);
+                }
+            }
+            break;
+    }
+}
+
+static void Host_Commit_Stores(void) {
+    while (Host_Pending_Size != 0) {
+        uint8_t addr = Host_Pending_Addr;
+        uint8_t size = Host_Pending_Size;
+        Host_Pending_Size = 0;
+        for (uint8_t i = 0; i < size; i++) {
+            Host_Write(addr + i, Host_Pending_Old[i], Host_IO[addr + i]);
+            Host_IO_Seen[addr + i] = Host_IO[addr + i];
+        }
+    }
+}
+
+// Applies the stores that had no hook (see Host_IO_Seen), each costing an
+// access. Call after Host_Commit_Stores(), before the model moves on.
+static void Host_Catch_Stores(void) {
+    uint8_t caught = 0;
+
+    if (memcmp(Host_IO_Seen, Host_IO, HOST_IO_SIZE) == 0) {
+        return;
+    }
+    for (uint8_t addr = 0; addr < HOST_IO_SIZE; addr++) {
+        if (Host_IO[addr] != Host_IO_Seen[addr]) {
+            Host_Count.reg_writes++;
+            Host_Write(addr, Host_IO_Seen[addr], Host_IO[addr]);
+            Host_IO_Seen[addr] = Host_IO[addr];
+            caught++;
+        }
+    }
+    Host_Advance(caught * HOST_ACCESS_CYCLES);
+}
+
+static void Host_Commit(void) {
+    Host_Commit_Stores();
+    Host_Catch_Stores();
+    Host_Dispatch();
+}
+
+// --- Access hooks (-fsanitize=kernel-address, outlined checks) ---
+static void Host_Access(uintptr_t addr, size_t size, uint8_t write) {
+    uintptr_t offset = addr - (uintptr_t)Host_IO;
+    if (offset >= HOST_IO_SIZE) {
+        Host_Count.mem_accesses++;
+        return;
+    }
+    Host_Commit();
+    if (size > HOST_IO_SIZE - offset) {
+        size = HOST_IO_SIZE - offset;
+    }
+    if (size > sizeof(Host_Pending_Old)) {
+        size = sizeof(Host_Pending_Old);
+    }
+
+    // Interrupts due before the instruction are taken first
+    Host_Advance(HOST_ACCESS_CYCLES);
+    if (write) {
+        Host_Count.reg_writes++;
+        memcpy(Host_Pending_Old, &Host_IO[offset], size);
+        Host_Pending_Addr = (uint8_t)offset;
+        Host_Pending_Size = (uint8_t)size;
+    } else {
+        Host_Count.reg_reads++;
+    }
+    Host_Leave();
+}
+
+#define HOST_HOOKS(size) \
+    void __asan_load##size##_noabort(uintptr_t addr); \
+    void __asan_store##size##_noabort(uintptr_t addr); \
+    void __asan_load##size##_noabort(uintptr_t addr) { Host_Access(addr, size, 0); } \
+    void __asan_store##size##_noabort(uintptr_t addr) { Host_Access(addr, size, 1); }
+HOST_HOOKS(1)
+HOST_HOOKS(2)
+HOST_HOOKS(4)
+HOST_HOOKS(8)
+HOST_HOOKS(16)
+
+void __asan_loadN_noabort(uintptr_t addr, size_t size);
+void __asan_storeN_noabort(uintptr_t addr, size_t size);
+void __asan_loadN_noabort(uintptr_t addr, size_t size) { Host_Access(addr, size, 0); }
+void __asan_storeN_noabort(uintptr_t addr, size_t size) { Host_Access(addr, size, 1); }
+
+// --- Call hooks (-finstrument-functions) ---
+void __cyg_profile_func_enter(void* fn, void* site);
+void __cyg_profile_func_exit(void* fn, void* site);
+void __cyg_profile_func_enter(void* fn, void* site) {
+    (void)fn;
+    (void)site;
+    Host_Count.calls++;
+}
+void __cyg_profile_func_exit(void* fn, void* site) {
+    (void)fn;
+    (void)site;
+}
+
+// --- Stand-in header functions ---
+void Host_Sei(void) {
+    Host_Commit();
+    Host_Advance(1);
+    Host_Count.reg_writes++;
+    Host_IO[HOST_SREG] |= (1 << SREG_I);
+    Host_Dispatch();
+    Host_Leave();
+}
+
+void Host_Cli(void) {
+    Host_Commit();
+    Host_Advance(1);
+    Host_Count.reg_writes++;
+    Host_IO[HOST_SREG] &= ~(1 << SREG_I);
+    Host_Leave();
+}
+
+void Host_Delay_us(double us) {
+    Host_Commit();
+    Host_Count.delay_ns += (uint64_t)(us * 1000.0 + 0.5);
+    Host_Advance((uint64_t)(us * (F_CPU / 1000000.0) + 0.5));
+    Host_Leave();
+}
+
+// --- API ---
+void Host_Reset(void) {
+    memset(Host_IO, 0, sizeof(Host_IO));
+    memset(&Host_Count, 0, sizeof(Host_Count));
+    memset(&Host_Timer0, 0, sizeof(Host_Timer));
+    memset(&Host_Timer1, 0, sizeof(Host_Timer));
+    memset(&Host_Timer2, 0, sizeof(Host_Timer));
+    memset(Host_Pin_Level, 0, sizeof(Host_Pin_Level));
+    Host_ADC_Left = 0;
+    Host_Pending_Size = 0;
+    Host_ISR_Depth = 0;
+    Host_Stop_Armed = 0;
+    Host_Leave();
+}
+
+uint8_t Host_Run(void (*entry)(void), uint64_t cycles) {
+    Host_Stop_At = Host_Count.cycles + cycles;
+    if (setjmp(Host_Stop_Jump) != 0) {
+        // Left wherever the firmware was, an ISR included
+        if (Host_ISR_Depth != 0) {
+            Host_ISR_Depth = 0;
+            Host_IO[HOST_SREG] |= (1 << SREG_I);
+        }
+        Host_Commit_Stores();
+        Host_Leave();
+        return 1;
+    }
+    Host_Stop_Armed = 1;
+    Host_Leave();
+    entry();
+    Host_Stop_Armed = 0;
+    Host_Commit();
+    Host_Leave();
+    return 0;
+}
+
+uint64_t Host_CPU_Cycles(void) {
+    return Host_Count.cycles + Host_Count.mem_accesses * HOST_MEM_CYCLES
+           + Host_Count.calls * HOST_CALL_CYCLES;
+}
+
+void Host_Idle(uint64_t cycles) {
+    Host_Commit();
+    Host_Advance(cycles);
+    Host_Leave();
+}
+
+void Host_Set_ADC(uint8_t channel, uint16_t code) {
+    Host_ADC_Input[channel & 0x07] = code;
+}
+
+void Host_Set_ADC_Source(uint16_t (*source)(uint8_t channel, uint64_t cycles)) {
+    Host_ADC_Source_Fn = source;
+}
+
+void Host_Drive(uint8_t pin, uint8_t mask, uint8_t level) {
+    uint8_t* driven = &Host_Pin_Level[(pin - HOST_PIND) / 3];
+    *driven = (*driven & ~mask) | (level & mask);
+    Host_Update_Pins(pin);
+}
+
+void Host_Set_Port_Hook(Host_Port_Hook hook) {
+    Host_Hook = hook;
+}
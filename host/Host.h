@@ -0,0 +1,121 @@
+/*
+ * File:   Host.h
+ * Author: Mostafa Eshra
+ *
+ * Description: Runs the firmware on the PC. The firmware sources are built
+ *              unchanged against the stand-in headers in host/avr and
+ *              host/util, with -fsanitize=kernel-address turned into a
+ *              register probe: the compiler puts a call before every load
+ *              and store, and the ones that land in Host_IO[] are register
+ *              accesses. Each of them is counted and costs HOST_ACCESS_CYCLES
+ *              on the model clock, which runs Timer0/1/2 (all WGM modes, no
+ *              output pins or input capture), the ADC (13 ADC clocks per
+ *              conversion, free running or auto-triggered) and dispatches
+ *              the ISRs in ATmega32 vector order.
+ *
+ * Only register accesses, delays and ISR entry/exit take model time: the
+ * cycles of the code between them are not modeled, so the clock runs
+ * slow against the target by whatever that code costs. Host_CPU_Cycles()
+ * adds an estimate of that code (SRAM accesses and calls) without moving
+ * the clock. GLCD_STATS on the target measures the real thing.
+ */
+
+#ifndef HOST_H
+#define	HOST_H
+
+#include <stdint.h>
+
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+// sbi/cbi (2 cycles) are a load and a store, in/out one access: 1 cycle each
+#define HOST_ACCESS_CYCLES     1
+// Interrupt response (4) + reti (4)
+#define HOST_ISR_CYCLES        8
+// Estimated costs of the work the clock does not time, for Host_CPU_Cycles():
+// ld/st/lds/sts take 2 cycles, call + ret 4 + 4 (prologue and epilogue not
+// counted)
+#define HOST_MEM_CYCLES        2
+#define HOST_CALL_CYCLES       8
+
+#define HOST_IO_SIZE           0x40
+
+// I/O addresses of the registers the model acts on
+#define HOST_SREG              0x3F
+#define HOST_OCR0              0x3C
+#define HOST_TIMSK             0x39
+#define HOST_TIFR              0x38
+#define HOST_TCCR0             0x33
+#define HOST_TCNT0             0x32
+#define HOST_SFIOR             0x30
+#define HOST_TCCR1A            0x2F
+#define HOST_TCCR1B            0x2E
+#define HOST_TCNT1             0x2C
+#define HOST_OCR1A             0x2A
+#define HOST_OCR1B             0x28
+#define HOST_ICR1              0x26
+#define HOST_TCCR2             0x25
+#define HOST_TCNT2             0x24
+#define HOST_OCR2              0x23
+#define HOST_PINA              0x19
+#define HOST_PINB              0x16
+#define HOST_PINC              0x13
+#define HOST_PIND              0x10
+#define HOST_ADMUX             0x07
+#define HOST_ADCSRA            0x06
+#define HOST_ADCL              0x04
+// PORTx is PINx + 2, DDRx PINx + 1
+#define HOST_PORT(pin)         ((pin) + 2)
+#define HOST_DDR(pin)          ((pin) + 1)
+
+typedef struct {
+    uint64_t cycles;        // Model clock
+    uint32_t reg_reads;
+    uint32_t reg_writes;
+    uint32_t e_strobes;     // Rising edges on GLCD E: one per bus transaction
+    uint32_t busy_reads;    // Of those, status reads (busy flag polls)
+    uint64_t delay_ns;      // Asked for with _delay_us / _delay_ms
+    uint32_t interrupts;    // ISRs run
+    uint64_t mem_accesses;  // Firmware SRAM loads and stores through pointers
+                            // and array indexes (the sanitizer leaves out the
+                            // direct ones to scalar globals and locals)
+    uint64_t calls;         // Firmware function calls (-finstrument-functions),
+                            // static inline functions excluded
+} Host_Counters;
+
+extern Host_Counters Host_Count;
+
+// Estimated CPU cycles so far: the model clock plus HOST_MEM_CYCLES per
+// counted SRAM access and HOST_CALL_CYCLES per call. A deterministic figure
+// for comparing builds, not a cycle-exact count: the ALU work between the
+// accesses is still not modeled.
+uint64_t Host_CPU_Cycles(void);
+
+// Power-on state: registers, timers, ADC, pins and counters
+void Host_Reset(void);
+
+// --- Running ---
+// Calls entry until it returns (0) or until cycles have passed on the model
+// clock (1). The model is left as it was at the stop, so several runs can
+// follow each other.
+uint8_t Host_Run(void (*entry)(void), uint64_t cycles);
+// Lets the model clock run (timers, ADC, ISRs) with the CPU doing nothing
+void Host_Idle(uint64_t cycles);
+
+// --- Inputs ---
+// Fixed ADC input codes per channel (0..1023), or a source called at every
+// conversion start with the channel and the model clock; NULL = fixed codes
+void Host_Set_ADC(uint8_t channel, uint16_t code);
+void Host_Set_ADC_Source(uint16_t (*source)(uint8_t channel, uint64_t cycles));
+// Level the outside world puts on the pins of a port (pin = HOST_PINx),
+// seen in PINx where DDRx is 0
+void Host_Drive(uint8_t pin, uint8_t mask, uint8_t level);
+
+// --- Devices ---
+// Called after every write to a PORTx or DDRx register (addr), with the old
+// and new values; a bus model drives its replies with Host_Drive
+typedef void (*Host_Port_Hook)(uint8_t addr, uint8_t old, uint8_t val);
+void Host_Set_Port_Hook(Host_Port_Hook hook);
+
+#endif	/* HOST_H */
@@ -0,0 +1,238 @@
+/*
+ * File:   KS0108.c
+ * Author: Mostafa Eshra
+ */
+
+#include "KS0108.h"
+#include <string.h>
+#include <avr/io.h>
+#include "Host.h"
+#include "GLCD.h"
+
+#define KS0108_BUSY_CYCLES   ((uint64_t)KS0108_BUSY_US * (F_CPU / 1000000UL))
+#define KS0108_GAP_CYCLES    ((uint64_t)KS0108_FRAME_GAP_US * (F_CPU / 1000000UL))
+
+// Status byte
+#define KS0108_STATUS_BUSY   0x80
+#define KS0108_STATUS_OFF    0x20
+#define KS0108_STATUS_RESET  0x10
+
+typedef struct {
+    uint8_t ram[GLCD_PAGES][64];
+    uint8_t page;
+    uint8_t column;
+    uint8_t start_line;
+    uint8_t on;
+    uint8_t read_latch;     // Data reads return the byte of the previous read
+    uint64_t busy_until;
+} KS0108_Chip;
+
+static KS0108_Chip KS0108_Chips[2];
+static uint8_t KS0108_In_Reset;
+
+// Frame being sent
+static uint8_t KS0108_Frame_Open;
+static uint32_t KS0108_Frame_Strobes;
+static uint32_t KS0108_Frame_Writes;
+static uint64_t KS0108_Frame_First;
+static uint64_t KS0108_Frame_Last;
+static KS0108_Stats KS0108_Totals;
+static uint32_t KS0108_Frame_Index;
+static KS0108_Frame_Hook KS0108_Hook;
+static KS0108_Busy_Source KS0108_Busy;
+
+static uint8_t KS0108_Control_Addr(void) {
+    return _SFR_IO_ADDR(GLCD_CONTROL_PORT_REG);
+}
+
+// Runs before the first transaction of the next frame, so the RAM still
+// holds the frame being closed
+static void KS0108_Close_Frame(void) {
+    if (!KS0108_Frame_Open) {
+        return;
+    }
+    KS0108_Frame_Open = 0;
+
+    uint32_t cycles = (uint32_t)(KS0108_Frame_Last - KS0108_Frame_First);
+    if (KS0108_Hook) {
+        KS0108_Frame frame = { KS0108_Frame_Index, KS0108_Frame_First,
+                               KS0108_Frame_Strobes, KS0108_Frame_Writes, cycles };
+        KS0108_Hook(&frame);
+    }
+    if (KS0108_Frame_Index++ == 0) {
+        KS0108_Totals.init_strobes = KS0108_Frame_Strobes;
+        return;
+    }
+    KS0108_Totals.frames++;
+    KS0108_Totals.strobes_sum += KS0108_Frame_Strobes;
+    KS0108_Totals.writes_sum += KS0108_Frame_Writes;
+    KS0108_Totals.cycles_sum += cycles;
+    if (KS0108_Frame_Strobes > KS0108_Totals.strobes_max) {
+        KS0108_Totals.strobes_max = KS0108_Frame_Strobes;
+    }
+    if (cycles > KS0108_Totals.cycles_max) {
+        KS0108_Totals.cycles_max = cycles;
+    }
+}
+
+// Chips taking part in a transaction: bit 0 = CS1 (left), bit 1 = CS2
+static uint8_t KS0108_Selected(uint8_t control) {
+    return ((control >> GLCD_CS1_PIN) & 1) | (((control >> GLCD_CS2_PIN) & 1) << 1);
+}
+
+static void KS0108_Write(KS0108_Chip* chip, uint8_t data_mode, uint8_t value) {
+    if (Host_Count.cycles < chip->busy_until) {
+        KS0108_Totals.violations++;
+    }
+    chip->busy_until = Host_Count.cycles + (KS0108_Busy ? KS0108_Busy() : KS0108_BUSY_CYCLES);
+
+    if (data_mode) {
+        chip->ram[chip->page][chip->column] = value;
+        chip->column = (chip->column + 1) & 0x3F;
+    } else if ((value & 0xFE) == GLCD_DISPLAY_OFF) {
+        chip->on = value & 0x01;
+    } else if ((value & 0xC0) == GLCD_SET_COLUMN_ADDR) {
+        chip->column = value & 0x3F;
+    } else if ((value & 0xF8) == GLCD_SET_PAGE_ADDR) {
+        chip->page = value & 0x07;
+    } else if ((value & 0xC0) == GLCD_START_LINE_ADDR) {
+        chip->start_line = value & 0x3F;
+    }
+}
+
+static uint8_t KS0108_Read(KS0108_Chip* chip, uint8_t data_mode) {
+    if (!data_mode) {
+        uint8_t status = 0;
+        if (KS0108_In_Reset) {
+            status |= KS0108_STATUS_RESET | KS0108_STATUS_BUSY;
+        } else if (Host_Count.cycles < chip->busy_until) {
+            status |= KS0108_STATUS_BUSY;
+        }
+        if (!chip->on) {
+            status |= KS0108_STATUS_OFF;
+        }
+        return status;
+    }
+    uint8_t value = chip->read_latch;
+    chip->read_latch = chip->ram[chip->page][chip->column];
+    chip->column = (chip->column + 1) & 0x3F;
+    return value;
+}
+
+static void KS0108_Port_Write(uint8_t addr, uint8_t old, uint8_t val) {
+    if (addr != KS0108_Control_Addr()) {
+        return;
+    }
+
+    uint8_t rising = val & ~old;
+    uint8_t falling = old & ~val;
+    uint8_t chips = KS0108_Selected(val);
+    uint8_t data_mode = (val >> GLCD_RS_PIN) & 1;
+    uint8_t read = (val >> GLCD_RW_PIN) & 1;
+
+    if (falling & (1 << GLCD_RST_PIN)) {
+        KS0108_In_Reset = 1;
+        for (uint8_t i = 0; i < 2; i++) {
+            KS0108_Chips[i].on = 0;
+            KS0108_Chips[i].start_line = 0;
+        }
+    }
+    if (rising & (1 << GLCD_RST_PIN)) {
+        KS0108_In_Reset = 0;
+    }
+
+    if (rising & (1 << GLCD_E_PIN)) {
+        if (KS0108_Frame_Open && Host_Count.cycles - KS0108_Frame_Last > KS0108_GAP_CYCLES) {
+            KS0108_Close_Frame();
+        }
+        if (!KS0108_Frame_Open) {
+            KS0108_Frame_Open = 1;
+            KS0108_Frame_Strobes = 0;
+            KS0108_Frame_Writes = 0;
+            KS0108_Frame_First = Host_Count.cycles;
+        }
+        KS0108_Frame_Strobes++;
+        KS0108_Frame_Last = Host_Count.cycles;
+
+        if (read) {
+            // Two chips driving the bus at once: the low levels win
+            uint8_t bus = 0xFF;
+            for (uint8_t i = 0; i < 2; i++) {
+                if (chips & (1 << i)) {
+                    bus &= KS0108_Read(&KS0108_Chips[i], data_mode);
+                }
+            }
+            Host_Drive(HOST_PINC, 0xFF, chips ? bus : 0);
+        }
+    }
+
+    if (falling & (1 << GLCD_E_PIN)) {
+        if (read) {
+            Host_Drive(HOST_PINC, 0xFF, 0);
+        } else if (!KS0108_In_Reset) {
+            uint8_t ddr = Host_IO[HOST_DDR(HOST_PINC)];
+            uint8_t bus = Host_IO[HOST_PORT(HOST_PINC)] & ddr;
+            KS0108_Frame_Writes++;
+            for (uint8_t i = 0; i < 2; i++) {
+                if (chips & (1 << i)) {
+                    KS0108_Write(&KS0108_Chips[i], data_mode, bus);
+                }
+            }
+        }
+    }
+}
+
+void KS0108_Init(void) {
+    memset(KS0108_Chips, 0, sizeof(KS0108_Chips));
+    memset(&KS0108_Totals, 0, sizeof(KS0108_Totals));
+    KS0108_In_Reset = 0;
+    KS0108_Frame_Open = 0;
+    KS0108_Frame_Index = 0;
+    KS0108_Hook = NULL;
+    KS0108_Busy = NULL;
+    Host_Set_Port_Hook(KS0108_Port_Write);
+}
+
+void KS0108_Set_Frame_Hook(KS0108_Frame_Hook hook) {
+    KS0108_Hook = hook;
+}
+
+void KS0108_Set_Busy_Source(KS0108_Busy_Source source) {
+    KS0108_Busy = source;
+}
+
+uint8_t KS0108_Pixel(uint8_t x, uint8_t y) {
+    const KS0108_Chip* chip = &KS0108_Chips[(x >> 6) & 1];
+
+    if (!chip->on) {
+        return 0;
+    }
+    uint8_t line = (y + chip->start_line) & 0x3F;
+    return (chip->ram[line >> 3][x & 0x3F] >> (line & 7)) & 1;
+}
+
+uint8_t KS0108_RAM(uint8_t x, uint8_t page) {
+    return KS0108_Chips[(x >> 6) & 1].ram[page & 0x07][x & 0x3F];
+}
+
+uint8_t KS0108_Start_Line(uint8_t chip) {
+    return KS0108_Chips[(chip == GLCD_CHIP_2) ? 1 : 0].start_line;
+}
+
+void KS0108_Write_PBM(FILE* file) {
+    fprintf(file, "P1\n%d %d\n", GLCD_WIDTH, GLCD_HEIGHT);
+    for (uint8_t y = 0; y < GLCD_HEIGHT; y++) {
+        for (uint8_t x = 0; x < GLCD_WIDTH; x++) {
+            fputc(KS0108_Pixel(x, y) ? '1' : '0', file);
+        }
+        fputc('\n', file);
+    }
+}
+
+void KS0108_Get_Stats(KS0108_Stats* stats) {
+    // The frame in progress counts once the bus has been quiet long enough
+    if (KS0108_Frame_Open && Host_Count.cycles - KS0108_Frame_Last > KS0108_GAP_CYCLES) {
+        KS0108_Close_Frame();
+    }
+    *stats = KS0108_Totals;
+}
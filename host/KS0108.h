@@ -0,0 +1,72 @@
+/*
+ * File:   KS0108.h
+ * Author: Mostafa Eshra
+ *
+ * Description: Behavioral model of the panel for the host build: the two
+ *              KS0108 controllers on the GLCD.h pins, each with its 8x64
+ *              byte RAM, page and column registers (the column counts up
+ *              by one per data byte, wrapping at 64), display start line,
+ *              on/off, reset and busy flag. Writes are latched on the
+ *              falling edge of E, status and data reads are driven onto
+ *              the data port while E is high.
+ *
+ * The datasheet gives no busy time, so each write keeps its chip busy for
+ * KS0108_BUSY_US (assumed), or for what a busy source returns. A write to
+ * a busy chip is counted as a violation and still applied. A frame is a
+ * burst of bus transactions: the first transaction after
+ * KS0108_FRAME_GAP_US of bus silence starts the next one.
+ */
+
+#ifndef KS0108_H
+#define	KS0108_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define KS0108_BUSY_US          2
+#define KS0108_FRAME_GAP_US     4000
+
+typedef struct {
+    uint32_t frames;            // Finished frames, the first (GLCD_Init) excluded
+    uint32_t strobes_max;       // Bus transactions (E strobes) per frame
+    uint64_t strobes_sum;
+    uint64_t writes_sum;        // Of them command and data writes
+    uint32_t cycles_max;        // First to last transaction, CPU cycles
+    uint64_t cycles_sum;
+    uint32_t init_strobes;      // The GLCD_Init frame on its own
+    uint32_t violations;        // Writes to a busy chip
+} KS0108_Stats;
+
+// One finished frame, as passed to the frame hook
+typedef struct {
+    uint32_t index;             // 0 = the GLCD_Init frame
+    uint64_t first;             // Model clock at its first transaction
+    uint32_t strobes;           // Bus transactions (E strobes)
+    uint32_t writes;            // Of them command and data writes
+    uint32_t cycles;            // First to last transaction, CPU cycles
+} KS0108_Frame;
+
+// Called once a frame has ended, with the panel showing it
+typedef void (*KS0108_Frame_Hook)(const KS0108_Frame* frame);
+// Busy time of each write in CPU cycles, asked for at the write
+typedef uint32_t (*KS0108_Busy_Source)(void);
+
+// Connects the model to the host ports (call after Host_Reset)
+void KS0108_Init(void);
+// NULL = none (the default after KS0108_Init)
+void KS0108_Set_Frame_Hook(KS0108_Frame_Hook hook);
+// NULL = KS0108_BUSY_US for every write (the default after KS0108_Init)
+void KS0108_Set_Busy_Source(KS0108_Busy_Source source);
+
+// Pixel as shown (start line applied, blank while the chip is off)
+uint8_t KS0108_Pixel(uint8_t x, uint8_t y);
+// Display RAM byte of column x (0-127) in a page, as the chip holds it
+uint8_t KS0108_RAM(uint8_t x, uint8_t page);
+// Start line of GLCD_CHIP_1 or GLCD_CHIP_2
+uint8_t KS0108_Start_Line(uint8_t chip);
+// The screen as a plain PBM (P1), one text line per pixel row
+void KS0108_Write_PBM(FILE* file);
+
+void KS0108_Get_Stats(KS0108_Stats* stats);
+
+#endif	/* KS0108_H */
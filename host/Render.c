@@ -0,0 +1,121 @@
+/*
+ * File:   Render.c
+ * Author: Mostafa Eshra
+ *
+ * Description: Runs the firmware with the KS0108 model on the port pins for
+ *              RENDER_MS of model time and writes what the panel shows as a
+ *              PBM. Built once per DISPLAY_VIEW; make host-render compares
+ *              the images with host/golden.
+ *              With frames.csv, one row per frame: its start, bus cycles (E
+ *              strobes), writes, and first to last transaction in CPU
+ *              cycles and microseconds (frame 0 is GLCD_Init). With a
+ *              prefix as well, each frame as <prefix><frame>.pbm.
+ *              Usage: render<view> out.pbm [frames.csv [prefix]]
+ */
+
+#include <stdio.h>
+#include "Host.h"
+#include "KS0108.h"
+
+#define RENDER_MS   1500
+
+int app_main(void);
+
+static void Render_App(void) {
+    app_main();
+}
+
+// Triangle from 0 to 1023 and back over period cycles
+static uint16_t Render_Triangle(uint64_t cycles, uint64_t period) {
+    uint32_t phase = (uint32_t)(((cycles % period) * 2046) / period);
+    return (phase < 1023) ? phase : 2046 - phase;
+}
+
+// ADC6 (displayed duty): 4 s triangle, so the strip chart has a slope.
+// ADC7 (scope channel): 1 kHz triangle, through the trigger level.
+static uint16_t Render_ADC(uint8_t channel, uint64_t cycles) {
+    if (channel == 7) {
+        return Render_Triangle(cycles, F_CPU / 1000UL);
+    }
+    return Render_Triangle(cycles, 4UL * F_CPU);
+}
+
+static FILE* Render_CSV;
+static const char* Render_Prefix;
+static uint8_t Render_Failed;
+
+static void Render_Frame(const KS0108_Frame* frame) {
+    const double us = F_CPU / 1000000.0;
+
+    fprintf(Render_CSV, "%lu,%.1f,%lu,%lu,%lu,%.1f\n", (unsigned long)frame->index, frame->first / us,
+            (unsigned long)frame->strobes, (unsigned long)frame->writes,
+            (unsigned long)frame->cycles, frame->cycles / us);
+    if (Render_Prefix != NULL) {
+        char path[256];
+        snprintf(path, sizeof(path), "%s%03lu.pbm", Render_Prefix, (unsigned long)frame->index);
+        FILE* file = fopen(path, "w");
+        if (file == NULL) {
+            perror(path);
+            Render_Failed = 1;
+            return;
+        }
+        KS0108_Write_PBM(file);
+        fclose(file);
+    }
+}
+
+int main(int argc, char** argv) {
+    KS0108_Stats stats;
+    FILE* file;
+
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s out.pbm [frames.csv [prefix]]\n", argv[0]);
+        return 2;
+    }
+
+    Host_Reset();
+    KS0108_Init();
+    if (argc > 2) {
+        Render_CSV = fopen(argv[2], "w");
+        if (Render_CSV == NULL) {
+            perror(argv[2]);
+            return 2;
+        }
+        fprintf(Render_CSV, "frame,start_us,bus_cycles,writes,cycles,us\n");
+        Render_Prefix = (argc > 3) ? argv[3] : NULL;
+        KS0108_Set_Frame_Hook(Render_Frame);
+    }
+    Host_Set_ADC_Source(Render_ADC);
+    Host_Run(Render_App, (uint64_t)RENDER_MS * (F_CPU / 1000UL));
+    KS0108_Get_Stats(&stats);
+    if (Render_CSV != NULL) {
+        fclose(Render_CSV);
+        if (Render_Failed) {
+            return 2;
+        }
+    }
+
+    file = fopen(argv[1], "w");
+    if (file == NULL) {
+        perror(argv[1]);
+        return 2;
+    }
+    KS0108_Write_PBM(file);
+    fclose(file);
+
+    printf("%s: init %lu bus cycles, then %lu frames", argv[1],
+           (unsigned long)stats.init_strobes, (unsigned long)stats.frames);
+    if (stats.frames != 0) {
+        printf(", per frame: %llu bus cycles (max %lu), %llu writes, %.0f us (max %.0f us)",
+               (unsigned long long)(stats.strobes_sum / stats.frames), (unsigned long)stats.strobes_max,
+               (unsigned long long)(stats.writes_sum / stats.frames),
+               stats.cycles_sum / (double)stats.frames / (F_CPU / 1000000UL),
+               stats.cycles_max / (double)(F_CPU / 1000000UL));
+    }
+    printf("\n");
+    if (stats.violations != 0) {
+        printf("%s: %lu writes to a busy chip\n", argv[1], (unsigned long)stats.violations);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,43 @@
+/*
+ * File:   Run.c
+ * Author: Mostafa Eshra
+ *
+ * Description: Runs the firmware (main.c's main, built as app_main) on the
+ *              host model for a given time and prints what it did to the
+ *              hardware (the panel is the KS0108 model).
+ *              Usage: run [ms] [adc6] [adc7]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "Host.h"
+#include "KS0108.h"
+
+int app_main(void);
+
+static void Run_App(void) {
+    app_main();
+}
+
+int main(int argc, char** argv) {
+    uint32_t ms = (argc > 1) ? (uint32_t)atol(argv[1]) : 1000;
+
+    Host_Reset();
+    KS0108_Init();
+    Host_Set_ADC(6, (argc > 2) ? (uint16_t)atoi(argv[2]) : 512);
+    Host_Set_ADC(7, (argc > 3) ? (uint16_t)atoi(argv[3]) : 256);
+    Host_Run(Run_App, (uint64_t)ms * (F_CPU / 1000UL));
+
+    double seconds = (double)Host_Count.cycles / F_CPU;
+    printf("%-22s %12s %12s\n", "", "total", "per second");
+    printf("%-22s %12llu\n", "model cycles", (unsigned long long)Host_Count.cycles);
+    printf("%-22s %12lu %12.0f\n", "register reads", (unsigned long)Host_Count.reg_reads, Host_Count.reg_reads / seconds);
+    printf("%-22s %12lu %12.0f\n", "register writes", (unsigned long)Host_Count.reg_writes, Host_Count.reg_writes / seconds);
+    printf("%-22s %12lu %12.0f\n", "GLCD E strobes", (unsigned long)Host_Count.e_strobes, Host_Count.e_strobes / seconds);
+    printf("%-22s %12lu %12.0f\n", "  of them busy reads", (unsigned long)Host_Count.busy_reads, Host_Count.busy_reads / seconds);
+    printf("%-22s %12.0f %12.0f\n", "delay requested (us)", Host_Count.delay_ns / 1000.0, Host_Count.delay_ns / 1000.0 / seconds);
+    printf("%-22s %12lu %12.0f\n", "interrupts", (unsigned long)Host_Count.interrupts, Host_Count.interrupts / seconds);
+    printf("%-22s %12llu %12.0f\n", "SRAM accesses", (unsigned long long)Host_Count.mem_accesses, Host_Count.mem_accesses / seconds);
+    printf("%-22s %12llu %12.0f\n", "function calls", (unsigned long long)Host_Count.calls, Host_Count.calls / seconds);
+    return 0;
+}
@@ -0,0 +1,200 @@
+/*
+ * File:   Test_Capture.c
+ * Author: Mostafa Eshra
+ *
+ * Description: Host test of Capture.c: the test plays Timer1 and the
+ *              interrupt controller around the two ISRs. Registers are a
+ *              plain Host_IO[] (no model), time is counted in Timer1 steps
+ *              (62.5 ns) and the counter wraps every CAPTURE_TIMER1_STEPS.
+ *              An edge is captured only if ICES1 selects it; ICR1 gets its
+ *              time, and the capture ISR runs after a random latency,
+ *              before a pending overflow ISR (vector order), with TOV1 set
+ *              when the counter wrapped in between. So both sides of the
+ *              "wrapped just before the capture" check are exercised.
+ *              - dithered OC0 (Timer0 /64, the fraction spread over 256
+ *                periods as TIMER0_DITHER does): every Capture_Get after
+ *                the first window must read the exact averages, steadily
+ *              - slow signals, published early by CAPTURE_AVERAGE_COUNTS
+ *              - no edges: 0% or 100% from the pin, then a signal again
+ */
+
+#include <stdio.h>
+#include <avr/io.h>
+#include "Capture.h"
+
+#define TEST_DITHER_SIGNALS   200
+#define TEST_SLOW_SIGNALS     200
+// Timer1 steps per Timer0 step (/64) and per OC0 period
+#define TEST_OC0_STEP         64UL
+#define TEST_OC0_PERIOD       (256UL * TEST_OC0_STEP)
+// Longest ISR latency before / after an edge, in Timer1 steps: below half
+// an overflow period, as the overflow check in the capture ISR assumes
+#define TEST_MAX_LATENCY      400
+
+static unsigned long Test_Checks = 0;
+static unsigned long Test_Failures = 0;
+
+// --- Stand-ins for host/Host.c ---
+uint8_t Host_IO[0x40];
+
+void Host_Sei(void) {
+    SREG |= 0x80;
+}
+
+void Host_Cli(void) {
+    SREG &= ~0x80;
+}
+
+void TIMER1_CAPT_vect(void);
+void TIMER1_OVF_vect(void);
+
+// --- Timer1 ---
+static uint64_t Sim_Next_Overflow;      // Timer1 time of the next wrap not yet handled
+static uint32_t Test_Seed = 12345;
+
+static uint32_t Test_Random(uint32_t range) {
+    Test_Seed = Test_Seed * 1103515245UL + 12345UL;
+    return (Test_Seed >> 8) % range;
+}
+
+// Overflow ISRs of every wrap up to time
+static void Sim_Overflows(uint64_t time) {
+    while (Sim_Next_Overflow <= time) {
+        TIMER1_OVF_vect();
+        Sim_Next_Overflow += CAPTURE_TIMER1_STEPS;
+    }
+}
+
+// One edge at time: the CPU is busy from a random time before it to a
+// random time after it, the ISRs pending then run in vector order
+static void Sim_Edge(uint64_t time, uint8_t rising) {
+    uint64_t busy_from = time - Test_Random(TEST_MAX_LATENCY);
+    uint64_t serviced = time + Test_Random(TEST_MAX_LATENCY);
+
+    Sim_Overflows(busy_from);
+    if (((TCCR1B >> ICES1) & 1) == rising) {
+        ICR1 = (uint16_t)(time % CAPTURE_TIMER1_STEPS);
+        TIFR = (1 << ICF1);
+        if (Sim_Next_Overflow <= serviced) {
+            TIFR |= (1 << TOV1);
+        }
+        TIMER1_CAPT_vect();
+    }
+    Sim_Overflows(serviced);
+}
+
+// --- Checks ---
+static void Test_Expect(const char* what, unsigned long got, unsigned long expected, unsigned long tolerance,
+                        unsigned long a, unsigned long b) {
+    unsigned long diff = (got > expected) ? got - expected : expected - got;
+
+    Test_Checks++;
+    if (diff > tolerance && Test_Failures++ < 20) {
+        printf("%s = %lu, expected %lu (signal %lu, %lu)\n", what, got, expected, a, b);
+    }
+}
+
+// OC0 at OCR0 = base, fraction/256 dithered: high is (OCR0 + 1) steps and
+// OCR0 is base + 1 in fraction of every 256 periods. From the first period
+// of the second window on, every reading must be the exact window average.
+static void Test_Dithered(uint64_t* time, uint8_t base, uint8_t fraction) {
+    uint32_t sum_high = 256UL * (base + 1) * TEST_OC0_STEP + (uint32_t)fraction * TEST_OC0_STEP;
+    uint32_t high = (sum_high + 128) / 256;
+    uint16_t duty = (uint16_t)(((256UL * (base + 1) + fraction) * 1000UL + 32768) / 65536);
+    uint32_t freq = (CAPTURE_TIMER1_HZ + TEST_OC0_PERIOD / 2) / TEST_OC0_PERIOD;
+    uint8_t accumulator = (uint8_t)Test_Random(256);
+
+    for (uint16_t p = 0; p < 3 * CAPTURE_AVERAGE_PERIODS; p++) {
+        uint8_t ocr = base;
+        if ((uint16_t)accumulator + fraction >= 256) {
+            ocr++;
+        }
+        accumulator += fraction;
+
+        Sim_Edge(*time, 1);
+        Sim_Edge(*time + (ocr + 1) * TEST_OC0_STEP, 0);
+        *time += TEST_OC0_PERIOD;
+
+        if (p > 2 * CAPTURE_AVERAGE_PERIODS) {
+            Capture_Result result;
+            Capture_Get(&result);
+            Test_Expect("dithered period", result.period, TEST_OC0_PERIOD, 0, base, fraction);
+            Test_Expect("dithered high", result.high, high, 0, base, fraction);
+            Test_Expect("dithered freq_hz", result.freq_hz, freq, 0, base, fraction);
+            Test_Expect("dithered duty_permille", result.duty_permille, duty, 0, base, fraction);
+        }
+    }
+}
+
+// Steady signal of period steps, high for high_steps of them, over two
+// windows. Duty may be one permille off: long windows are scaled down to
+// keep high * 1000 inside 32 bits.
+static void Test_Slow(uint64_t* time, uint32_t period, uint32_t high_steps) {
+    uint32_t count = 0;
+    uint32_t sum = 0;
+
+    // Periods until the first complete window, as the ISR counts them
+    do {
+        count++;
+        sum += period;
+    } while (count < CAPTURE_AVERAGE_PERIODS && sum < CAPTURE_AVERAGE_COUNTS);
+
+    for (uint32_t p = 0; p < 3 * count + 2; p++) {
+        Sim_Edge(*time, 1);
+        Sim_Edge(*time + high_steps, 0);
+        *time += period;
+    }
+
+    Capture_Result result;
+    Capture_Get(&result);
+    Test_Expect("slow period", result.period, period, 0, period, high_steps);
+    Test_Expect("slow high", result.high, high_steps, 0, period, high_steps);
+    Test_Expect("slow freq_hz", result.freq_hz, (CAPTURE_TIMER1_HZ + period / 2) / period, 0, period, high_steps);
+    Test_Expect("slow duty_permille", result.duty_permille,
+                (uint32_t)(((uint64_t)high_steps * 1000 + period / 2) / period), 1, period, high_steps);
+}
+
+// No edges for longer than CAPTURE_IDLE_OVERFLOWS: the pin level decides
+static void Test_Idle(uint64_t* time, uint8_t level) {
+    if (level) {
+        PIND |= (1 << PD6);
+    } else {
+        PIND &= ~(1 << PD6);
+    }
+    *time += (CAPTURE_IDLE_OVERFLOWS + 2) * CAPTURE_TIMER1_STEPS;
+    Sim_Overflows(*time);
+
+    Capture_Result result;
+    Capture_Get(&result);
+    Test_Expect("idle period", result.period, 0, 0, level, 0);
+    Test_Expect("idle freq_hz", result.freq_hz, 0, 0, level, 0);
+    Test_Expect("idle duty_permille", result.duty_permille, level ? 1000 : 0, 0, level, 0);
+    PIND &= ~(1 << PD6);
+}
+
+int main(void) {
+    uint64_t time = 5 * CAPTURE_TIMER1_STEPS;
+
+    Sim_Next_Overflow = CAPTURE_TIMER1_STEPS;
+    Capture_Init();
+
+    // The case the dither averaging was made for, then random ones
+    Test_Dithered(&time, 100, 77);
+    for (uint16_t i = 0; i < TEST_DITHER_SIGNALS; i++) {
+        Test_Dithered(&time, (uint8_t)(8 + Test_Random(240)), (uint8_t)Test_Random(256));
+    }
+
+    for (uint16_t i = 0; i < TEST_SLOW_SIGNALS; i++) {
+        uint32_t period = 2 * TEST_MAX_LATENCY + 4 + Test_Random(400000);
+        uint32_t high = TEST_MAX_LATENCY + 1 + Test_Random(period - 2 * TEST_MAX_LATENCY - 2);
+        Test_Slow(&time, period, high);
+    }
+
+    Test_Idle(&time, 1);
+    Test_Dithered(&time, 30, 200);
+    Test_Idle(&time, 0);
+    Test_Dithered(&time, 200, 1);
+
+    printf("Test_Capture: %lu checks, %lu failures\n", Test_Checks, Test_Failures);
+    return Test_Failures != 0;
+}
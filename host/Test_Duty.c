@@ -0,0 +1,57 @@
+/*
+ * File:   Test_Duty.c
+ * Author: Mostafa Eshra
+ *
+ * Description: Exhaustive host test of Duty.c against the float code it
+ *              replaced in main.c:
+ *                  duty_cycle_val = (uint8_t)(adc_val/4);
+ *                  PWM_Per = (adc_val/1023.0) * 100;      (float PWM_Per)
+ *                  (uint8_t)(PWM_Per)
+ *                  round((PWM_Per/100) * 64)
+ *              avr-gcc's double is 32 bits, so the reference runs in float
+ *              (volatile, so every step is rounded to float). Duty_To_Width
+ *              is also checked for every width 1-255 against exact integer
+ *              rounding, and DUTY_DIV_1023 over its whole documented range.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include "Duty.h"
+
+static unsigned long Test_Checks = 0;
+static unsigned long Test_Failures = 0;
+
+static void Test_Expect(unsigned long got, unsigned long expected, const char* what, unsigned long a, unsigned long b) {
+    Test_Checks++;
+    if (got != expected) {
+        if (Test_Failures++ < 20) {
+            printf("%s(%lu, %lu) = %lu, expected %lu\n", what, a, b, got, expected);
+        }
+    }
+}
+
+int main(void) {
+    for (uint16_t adc = 0; adc <= DUTY_ADC_MAX; adc++) {
+        volatile float per = adc / 1023.0f;
+        per = per * 100;
+        volatile float signal = per / 100;
+        signal = signal * 64;
+
+        Test_Expect(Duty_To_OCR(adc), (uint8_t)(adc / 4), "Duty_To_OCR", adc, 0);
+        Test_Expect(Duty_To_Percent(adc), (uint8_t)per, "Duty_To_Percent", adc, 0);
+        Test_Expect(Duty_To_Width(adc, 64), (uint8_t)roundf(signal), "Duty_To_Width float", adc, 64);
+
+        // round(a * w / 1023), ties away from zero, in exact integers
+        for (uint16_t width = 1; width <= 255; width++) {
+            uint32_t exact = ((uint32_t)adc * width * 2 + DUTY_ADC_MAX) / (2 * DUTY_ADC_MAX);
+            Test_Expect(Duty_To_Width(adc, (uint8_t)width), exact, "Duty_To_Width", adc, width);
+        }
+    }
+
+    for (uint32_t x = 0; x < (1UL << 20) - 1; x++) {
+        Test_Expect(DUTY_DIV_1023(x), x / 1023, "DUTY_DIV_1023", x, 0);
+    }
+
+    printf("Test_Duty: %lu checks, %lu failures\n", Test_Checks, Test_Failures);
+    return Test_Failures != 0;
+}
@@ -0,0 +1,150 @@
+/*
+ * File:   Test_Filter.c
+ * Author: Mostafa Eshra
+ *
+ * Description: Host test of Filter.h / Filter.c, built once per FILTER_TYPE.
+ *              Random 10-bit samples (noise, steps, full-scale runs) go to
+ *              the FILTER_CHANNELS channels in random order, with a
+ *              Filter_Reset now and then, and every Filter_Push is checked
+ *              against a reference per channel:
+ *              - FILTER_NONE: the sample itself
+ *              - FILTER_OVERSAMPLE: an output every 4^n samples, the sum of
+ *                those >> n, and no output in between
+ *              - FILTER_IIR: y += (x - y) / 2^k in exact arithmetic,
+ *                seeded with the first sample. The shift truncates, so
+ *                the state runs up to (2^k - 1) / 2^k above it, and the
+ *                rounded output from 0.5 below to that plus 0.5 above.
+ *              - FILTER_BOXCAR: the exact floor of the mean of the last
+ *                2^k samples, the window first filled with the first one
+ *              Outputs must stay inside FILTER_BITS.
+ */
+
+#include <stdio.h>
+#include "Filter.h"
+
+#define TEST_SAMPLES   2000000UL
+#define TEST_RESETS    1000         // One Filter_Reset per this many samples, on average
+
+static unsigned long Test_Checks = 0;
+static unsigned long Test_Failures = 0;
+static uint32_t Test_Seed = 99;
+
+static uint32_t Test_Random(uint32_t range) {
+    Test_Seed = Test_Seed * 1103515245UL + 12345UL;
+    return (Test_Seed >> 8) % range;
+}
+
+// --- Reference, per channel ---
+typedef struct {
+    uint32_t count;         // Samples since the last reset
+    uint32_t sum;           // Oversample: samples of the current output
+    double y;               // IIR
+    uint16_t window[16];    // Boxcar: newest last
+    uint16_t level;         // Input generator: current level
+} Ref_Channel;
+
+static Ref_Channel Ref[FILTER_CHANNELS];
+
+static void Ref_Reset(void) {
+    for (uint8_t ch = 0; ch < FILTER_CHANNELS; ch++) {
+        Ref[ch].count = 0;
+        Ref[ch].sum = 0;
+    }
+}
+
+// Expected output of a push: returns 1 and sets *expected when one is due.
+// The filter may be up to *below under it and *above over it.
+static uint8_t Ref_Push(uint8_t ch, uint16_t sample, double* expected, double* below, double* above) {
+    Ref_Channel* r = &Ref[ch];
+
+    *below = 0;
+    *above = 0;
+#if FILTER_TYPE == FILTER_OVERSAMPLE
+    r->sum += sample;
+    if (++r->count % (1UL << (2 * FILTER_OVERSAMPLE_N)) != 0) {
+        return 0;
+    }
+    *expected = r->sum >> FILTER_OVERSAMPLE_N;
+    r->sum = 0;
+    return 1;
+#elif FILTER_TYPE == FILTER_IIR
+    if (r->count++ == 0) {
+        r->y = sample;
+    } else {
+        r->y += (sample - r->y) / (1 << FILTER_IIR_SHIFT);
+    }
+    *expected = r->y;
+    *below = 0.5;
+    *above = 0.5 + (double)((1 << FILTER_IIR_SHIFT) - 1) / (1 << FILTER_IIR_SHIFT);
+    return 1;
+#elif FILTER_TYPE == FILTER_BOXCAR
+    uint32_t sum = 0;
+    for (uint8_t i = 0; i < FILTER_BOXCAR_LEN; i++) {
+        r->window[i] = (r->count == 0 || i == FILTER_BOXCAR_LEN - 1) ? sample : r->window[i + 1];
+        sum += r->window[i];
+    }
+    r->count++;
+    *expected = sum >> FILTER_BOXCAR_SHIFT;
+    return 1;
+#else
+    (void)r;
+    *expected = sample;
+    return 1;
+#endif
+}
+
+// Noise around a level that steps now and then, with full-scale runs
+static uint16_t Test_Sample(uint8_t ch) {
+    Ref_Channel* r = &Ref[ch];
+
+    switch (Test_Random(64)) {
+        case 0:
+            r->level = (uint16_t)Test_Random(1024);
+            break;
+        case 1:
+            r->level = 0;
+            break;
+        case 2:
+            r->level = 1023;
+            break;
+    }
+    int sample = r->level + (int)Test_Random(9) - 4;
+    if (Test_Random(16) == 0) {
+        sample = (int)Test_Random(1024);
+    }
+    return (uint16_t)((sample < 0) ? 0 : (sample > 1023) ? 1023 : sample);
+}
+
+int main(void) {
+    Filter_Reset();
+    Ref_Reset();
+
+    for (unsigned long i = 0; i < TEST_SAMPLES; i++) {
+        uint8_t ch = (uint8_t)Test_Random(FILTER_CHANNELS);
+        uint16_t sample = Test_Sample(ch);
+        uint16_t out = 0xFFFF;
+        double expected;
+        double below;
+        double above;
+
+        if (Test_Random(TEST_RESETS) == 0) {
+            Filter_Reset();
+            Ref_Reset();
+        }
+
+        uint8_t due = Ref_Push(ch, sample, &expected, &below, &above);
+        uint8_t got = Filter_Push(ch, sample, &out);
+
+        Test_Checks++;
+        if (got != due || (got && (out < expected - below - 1e-9 || out > expected + above + 1e-9
+                                   || out >= (1UL << FILTER_BITS)))) {
+            if (Test_Failures++ < 20) {
+                printf("sample %lu, channel %u, input %u: output %u (%u), expected %.2f (%u)\n",
+                       i, ch, sample, got ? out : 0, got, due ? expected : 0, due);
+            }
+        }
+    }
+
+    printf("Test_Filter (FILTER_TYPE=%d): %lu checks, %lu failures\n", FILTER_TYPE, Test_Checks, Test_Failures);
+    return Test_Failures != 0;
+}
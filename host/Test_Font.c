@@ -0,0 +1,521 @@
+/*
+ * File:   Test_Font.c
+ * Author: Mostafa Eshra
+ *
+ * Description: Host test of Font.c against the source bitmaps of both
+ *              fonts, on a framebuffer that stands in for GLCD_ReadByte /
+ *              GLCD_WriteByte:
+ *              - Font_Small: the FONT_DATA glyphs of GLCD_Font.h with their
+ *                blank columns trimmed (an empty glyph keeps 2 columns)
+ *              - Font_Digits_16: the bitmaps below, one string per row
+ *              Every character's width (missing ones fall back to the
+ *              first glyph), then TEST_GLYPHS random glyphs and TEST_STRINGS
+ *              random strings at random x/y over random framebuffer
+ *              contents, past the right and bottom edges too. Each is
+ *              compared pixel by pixel: the glyph's rows of its columns
+ *              show the glyph (opaque), the gaps between glyphs are blank
+ *              and everything else is untouched. The returned column is
+ *              checked as well.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "Font.h"
+#include "GLCD.h"
+#include "GLCD_Font.h"
+
+#define TEST_GLYPHS    20000UL
+#define TEST_STRINGS   5000UL
+
+static unsigned long Test_Checks = 0;
+static unsigned long Test_Failures = 0;
+
+// --- Framebuffer ---
+static uint8_t Test_FB[GLCD_PAGES][GLCD_WIDTH];
+
+uint8_t GLCD_ReadByte(uint8_t page, uint8_t column) {
+    return Test_FB[page][column];
+}
+
+void GLCD_WriteByte(uint8_t page, uint8_t column, uint8_t data) {
+    Test_FB[page][column] = data;
+}
+
+static uint8_t Test_Pixel(int x, int y) {
+    return (Test_FB[y >> 3][x] >> (y & 7)) & 1;
+}
+
+// --- Source bitmaps ---
+#define TEST_MAX_WIDTH   16
+
+typedef struct {
+    char ch;
+    const char* rows[16];
+} Test_Art;
+
+static const Test_Art Test_Digits_Art[] = {
+    { ' ', {
+        "..........",
+        "..........",
+        "..........",
+        "..........",
+        "..........",
+        "..........",
+        "..........",
+        "..........",
+        "..........",
+        "..........",
+        "..........",
+        "..........",
+        "..........",
+        "..........",
+        "..........",
+        "..........",
+    } },
+    { '%', {
+        ".###......##",
+        "##.##.....##",
+        "##.##....##.",
+        ".###....##..",
+        ".......##...",
+        "......##....",
+        "......##....",
+        ".....##.....",
+        ".....##.....",
+        "....##......",
+        "....##......",
+        "...##.......",
+        "..##....###.",
+        ".##....##.##",
+        "##.....##.##",
+        "##......###.",
+    } },
+    { '-', {
+        ".......",
+        ".......",
+        ".......",
+        ".......",
+        ".......",
+        ".......",
+        ".......",
+        "#######",
+        "#######",
+        ".......",
+        ".......",
+        ".......",
+        ".......",
+        ".......",
+        ".......",
+        ".......",
+    } },
+    { '.', {
+        "..",
+        "..",
+        "..",
+        "..",
+        "..",
+        "..",
+        "..",
+        "..",
+        "..",
+        "..",
+        "..",
+        "..",
+        "..",
+        "..",
+        "##",
+        "##",
+    } },
+    { '0', {
+        "..######..",
+        ".########.",
+        "###....###",
+        "##......##",
+        "##......##",
+        "##......##",
+        "##......##",
+        "##......##",
+        "##......##",
+        "##......##",
+        "##......##",
+        "##......##",
+        "##......##",
+        "###....###",
+        ".########.",
+        "..######..",
+    } },
+    { '1', {
+        "..##..",
+        ".###..",
+        "####..",
+        "..##..",
+        "..##..",
+        "..##..",
+        "..##..",
+        "..##..",
+        "..##..",
+        "..##..",
+        "..##..",
+        "..##..",
+        "..##..",
+        "..##..",
+        "######",
+        "######",
+    } },
+    { '2', {
+        ".#######..",
+        "#########.",
+        "##.....###",
+        ".......###",
+        ".......##.",
+        "......###.",
+        ".....###..",
+        "....###...",
+        "...###....",
+        "..###.....",
+        ".###......",
+        "###.......",
+        "##........",
+        "##........",
+        "##########",
+        "##########",
+    } },
+    { '3', {
+        ".########.",
+        "##########",
+        "##......##",
+        "........##",
+        "........##",
+        ".......##.",
+        "...#####..",
+        "...######.",
+        "........##",
+        "........##",
+        "........##",
+        "........##",
+        "##......##",
+        "###....###",
+        ".########.",
+        "..######..",
+    } },
+    { '4', {
+        "......###.",
+        ".....####.",
+        "....#####.",
+        "...###.##.",
+        "..###..##.",
+        ".###...##.",
+        "###....##.",
+        "##.....##.",
+        "##########",
+        "##########",
+        ".......##.",
+        ".......##.",
+        ".......##.",
+        ".......##.",
+        ".......##.",
+        ".......##.",
+    } },
+    { '5', {
+        "##########",
+        "##########",
+        "##........",
+        "##........",
+        "##........",
+        "########..",
+        "#########.",
+        ".......###",
+        "........##",
+        "........##",
+        "........##",
+        "........##",
+        "##......##",
+        "###....###",
+        ".########.",
+        "..######..",
+    } },
+    { '6', {
+        "..######..",
+        ".########.",
+        "###....###",
+        "##........",
+        "##........",
+        "##........",
+        "##.#####..",
+        "#########.",
+        "###....###",
+        "##......##",
+        "##......##",
+        "##......##",
+        "##......##",
+        "###....###",
+        ".########.",
+        "..######..",
+    } },
+    { '7', {
+        "##########",
+        "##########",
+        "........##",
+        ".......###",
+        ".......##.",
+        "......###.",
+        "......##..",
+        ".....###..",
+        ".....##...",
+        "....###...",
+        "....##....",
+        "...###....",
+        "...##.....",
+        "...##.....",
+        "...##.....",
+        "...##.....",
+    } },
+    { '8', {
+        "..######..",
+        ".########.",
+        "###....###",
+        "##......##",
+        "##......##",
+        "###....###",
+        ".########.",
+        ".########.",
+        "###....###",
+        "##......##",
+        "##......##",
+        "##......##",
+        "##......##",
+        "###....###",
+        ".########.",
+        "..######..",
+    } },
+    { '9', {
+        "..######..",
+        ".########.",
+        "###....###",
+        "##......##",
+        "##......##",
+        "##......##",
+        "##......##",
+        "###....###",
+        ".#########",
+        "..#####.##",
+        "........##",
+        "........##",
+        "........##",
+        "###....###",
+        ".########.",
+        "..######..",
+    } },
+};
+#define TEST_DIGITS_ART  (sizeof(Test_Digits_Art) / sizeof(Test_Digits_Art[0]))
+
+// Expected glyphs of one font, one column of bits per entry (bit 0 = top)
+typedef struct {
+    const Font* font;
+    uint8_t width[128];
+    uint32_t columns[128][TEST_MAX_WIDTH];
+} Test_Font;
+
+static Test_Font Test_Small;
+static Test_Font Test_Digits;
+
+static void Test_Load_Small(void) {
+    Test_Small.font = &Font_Small;
+    for (int ch = FONT_START_CHAR; ch <= FONT_END_CHAR; ch++) {
+        const uint8_t* glyph = FONT_DATA[ch - FONT_START_CHAR];
+        int first = 0;
+        int last = FONT_WIDTH - 1;
+
+        while (first < FONT_WIDTH && glyph[first] == 0) {
+            first++;
+        }
+        while (last >= 0 && glyph[last] == 0) {
+            last--;
+        }
+        if (first > last) {
+            // Blank (space): 2 empty columns
+            Test_Small.width[ch] = 2;
+            continue;
+        }
+        Test_Small.width[ch] = last - first + 1;
+        for (int c = first; c <= last; c++) {
+            Test_Small.columns[ch][c - first] = glyph[c];
+        }
+    }
+}
+
+static void Test_Load_Digits(void) {
+    Test_Digits.font = &Font_Digits_16;
+    for (unsigned i = 0; i < TEST_DIGITS_ART; i++) {
+        const Test_Art* art = &Test_Digits_Art[i];
+        uint8_t ch = (uint8_t)art->ch;
+
+        Test_Digits.width[ch] = strlen(art->rows[0]);
+        for (int row = 0; row < 16; row++) {
+            for (int c = 0; c < Test_Digits.width[ch]; c++) {
+                if (art->rows[row][c] == '#') {
+                    Test_Digits.columns[ch][c] |= (uint32_t)1 << row;
+                }
+            }
+        }
+    }
+}
+
+// Characters missing from the font are drawn as its first one
+static uint8_t Test_Glyph(const Test_Font* f, char ch) {
+    if (ch < f->font->first || ch > f->font->last || f->width[(uint8_t)ch] == 0) {
+        return (uint8_t)f->font->first;
+    }
+    return (uint8_t)ch;
+}
+
+// --- Reference ---
+// -1 = untouched, else the expected pixel
+static int8_t Test_Expect[GLCD_HEIGHT][GLCD_WIDTH];
+
+static void Ref_Column(int x, int y, uint32_t bits, int height) {
+    for (int row = 0; row < height; row++) {
+        if (x < GLCD_WIDTH && y + row < GLCD_HEIGHT) {
+            Test_Expect[y + row][x] = (bits >> row) & 1;
+        }
+    }
+}
+
+static int Ref_Char(const Test_Font* f, int x, int y, char ch) {
+    uint8_t g = Test_Glyph(f, ch);
+
+    for (int c = 0; c < f->width[g]; c++) {
+        Ref_Column(x + c, y, f->columns[g][c], f->font->height);
+    }
+    return x + f->width[g];
+}
+
+// Same walk as Font_Draw_String(), so the returned column can be compared
+static int Ref_String(const Test_Font* f, int x, int y, const char* str) {
+    for (const char* p = str; *p != '\0' && x < GLCD_WIDTH; p++) {
+        if (p != str) {
+            for (int s = 0; s < f->font->spacing && x < GLCD_WIDTH; s++) {
+                Ref_Column(x++, y, 0, f->font->height);
+            }
+        }
+        x = Ref_Char(f, x, y, *p);
+    }
+    return x;
+}
+
+// --- Cases ---
+static uint32_t Test_Seed = 12345;
+
+static uint32_t Test_Random(uint32_t range) {
+    Test_Seed = Test_Seed * 1103515245UL + 12345UL;
+    return (Test_Seed >> 8) % range;
+}
+
+static void Test_Start(uint8_t* before) {
+    for (int page = 0; page < GLCD_PAGES; page++) {
+        for (int x = 0; x < GLCD_WIDTH; x++) {
+            Test_FB[page][x] = (uint8_t)Test_Random(256);
+        }
+    }
+    memcpy(before, Test_FB, sizeof(Test_FB));
+    memset(Test_Expect, -1, sizeof(Test_Expect));
+}
+
+static void Test_Compare(const uint8_t* before, const char* what, const char* text, int x, int y,
+                         int got_end, int expected_end) {
+    unsigned wrong = 0;
+
+    for (int py = 0; py < GLCD_HEIGHT; py++) {
+        for (int px = 0; px < GLCD_WIDTH; px++) {
+            int expected = Test_Expect[py][px];
+            if (expected < 0) {
+                expected = (before[(py >> 3) * GLCD_WIDTH + px] >> (py & 7)) & 1;
+            }
+            if (Test_Pixel(px, py) != expected) {
+                wrong++;
+            }
+        }
+    }
+    Test_Checks++;
+    if ((wrong != 0 || got_end != expected_end) && Test_Failures++ < 20) {
+        printf("%s(\"%s\", x %d, y %d): %u pixels differ, returned %d, expected %d\n",
+               what, text, x, y, wrong, got_end, expected_end);
+    }
+}
+
+static void Test_Widths(const Test_Font* f) {
+    for (int ch = 1; ch < 128; ch++) {
+        uint8_t got = Font_Char_Width(f->font, (char)ch);
+        Test_Checks++;
+        if (got != f->width[Test_Glyph(f, (char)ch)] && Test_Failures++ < 20) {
+            printf("Font_Char_Width(%u) = %u, expected %u\n", ch, got, f->width[Test_Glyph(f, (char)ch)]);
+        }
+    }
+}
+
+// Mostly characters of the font, some just outside it or missing from it
+static char Test_Random_Char(const Test_Font* f) {
+    int first = f->font->first - 2;
+    int last = f->font->last + 2;
+    return (char)(first + (int)Test_Random(last - first + 1));
+}
+
+static void Test_Random_Glyph(void) {
+    static uint8_t before[GLCD_PAGES * GLCD_WIDTH];
+    const Test_Font* f = Test_Random(2) ? &Test_Digits : &Test_Small;
+    char text[2] = { Test_Random_Char(f), '\0' };
+    int x = (int)Test_Random(GLCD_WIDTH + 12);
+    int y = (int)Test_Random(GLCD_HEIGHT + 8);
+
+    Test_Start(before);
+    int end = Font_Draw_Char(f->font, x, y, text[0]);
+    Test_Compare(before, "Font_Draw_Char", text, x, y, end, Ref_Char(f, x, y, text[0]));
+}
+
+static void Test_Random_String(void) {
+    static uint8_t before[GLCD_PAGES * GLCD_WIDTH];
+    const Test_Font* f = Test_Random(2) ? &Test_Digits : &Test_Small;
+    char text[12];
+    int len = 1 + (int)Test_Random(sizeof(text) - 1);
+    int x = (int)Test_Random(GLCD_WIDTH);
+    int y = (int)Test_Random(GLCD_HEIGHT + 8);
+
+    for (int i = 0; i < len; i++) {
+        text[i] = Test_Random_Char(f);
+        if (text[i] == '\0') {
+            text[i] = ' ';
+        }
+    }
+    text[len] = '\0';
+
+    Test_Start(before);
+    int end = Font_Draw_String(f->font, x, y, text);
+    Test_Compare(before, "Font_Draw_String", text, x, y, end, Ref_String(f, x, y, text));
+
+    // The width of the whole string, whatever was clipped
+    int width = 0;
+    for (int i = 0; i < len; i++) {
+        width += (i ? f->font->spacing : 0) + f->width[Test_Glyph(f, text[i])];
+    }
+    Test_Checks++;
+    if (Font_String_Width(f->font, text) != width && Test_Failures++ < 20) {
+        printf("Font_String_Width(\"%s\") = %u, expected %d\n", text, Font_String_Width(f->font, text), width);
+    }
+}
+
+int main(void) {
+    Test_Load_Small();
+    Test_Load_Digits();
+
+    Test_Widths(&Test_Small);
+    Test_Widths(&Test_Digits);
+    for (unsigned long i = 0; i < TEST_GLYPHS; i++) {
+        Test_Random_Glyph();
+    }
+    for (unsigned long i = 0; i < TEST_STRINGS; i++) {
+        Test_Random_String();
+    }
+
+    printf("Test_Font: %lu checks, %lu failures\n", Test_Checks, Test_Failures);
+    return Test_Failures != 0;
+}
@@ -0,0 +1,298 @@
+/*
+ * File:   Test_Format.c
+ * Author: Mostafa Eshra
+ *
+ * Description: Host test of Format.c against printf("%*d"):
+ *              - Format_Number8 and Format_Number16 for every value,
+ *                Format_Number32 for the edges (INT32_MIN, -1, 0, the powers
+ *                of ten and their neighbours, INT32_MAX, UINT32_MAX) and a
+ *                pseudo-random sweep
+ *              - every flag combination (FORMAT_SIGNED, FORMAT_PERCENT,
+ *                FORMAT_ZERO_PAD) and every width up to past the longest
+ *                output, the returned length included
+ *              Then compares Format_Number32 with the int_to_string it
+ *              replaced (the % 10 / 10 plus reverse() version, copied below
+ *              as it was) on x86-64 instructions per call, counted by
+ *              single-stepping a child process with ptrace, and on wall
+ *              time. The x86 compiler turns / 10 into a multiply, which
+ *              the AVR cannot do: avr-gcc calls libgcc's __divmodsi4 once
+ *              per digit (quotient and remainder together), a 32-step
+ *              shift-subtract loop. The old version is therefore counted a
+ *              second time with that loop in place of % and /.
+ */
+
+#include <inttypes.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/ptrace.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include "Format.h"
+
+static unsigned long Test_Checks = 0;
+static unsigned long Test_Failures = 0;
+
+// --- Equivalence with printf ---
+// Expected text of one call: printf's %*d / %0*d, then the optional '%'
+static void Test_Expected(char* out, int64_t value, uint8_t width, uint8_t flags) {
+    int len = snprintf(out, 32, (flags & FORMAT_ZERO_PAD) ? "%0*" PRId64 : "%*" PRId64, width, value);
+    if (flags & FORMAT_PERCENT) {
+        strcpy(&out[len], "%");
+    }
+}
+
+static void Test_Compare(const char* what, int64_t value, uint8_t width, uint8_t flags,
+                         const char* got, uint8_t got_len) {
+    char expected[40];
+
+    Test_Expected(expected, value, width, flags);
+    Test_Checks++;
+    if (strcmp(got, expected) != 0 || got_len != strlen(expected)) {
+        if (Test_Failures++ < 20) {
+            printf("%s(%" PRId64 ", width %u, flags 0x%02X) = \"%s\" (%u), expected \"%s\"\n",
+                   what, value, width, flags, got, got_len, expected);
+        }
+    }
+}
+
+static void Test_Number8(uint8_t value) {
+    char buffer[FORMAT_MAX_LEN + 8];
+
+    for (uint8_t flags = 0; flags < 8; flags++) {
+        int64_t expected = (flags & FORMAT_SIGNED) ? (int64_t)(int8_t)value : (int64_t)value;
+        for (uint8_t width = 0; width <= 6; width++) {
+            uint8_t len = Format_Number8(buffer, value, width, flags);
+            Test_Compare("Format_Number8", expected, width, flags, buffer, len);
+        }
+    }
+}
+
+static void Test_Number16(uint16_t value) {
+    char buffer[FORMAT_MAX_LEN + 8];
+
+    for (uint8_t flags = 0; flags < 8; flags++) {
+        int64_t expected = (flags & FORMAT_SIGNED) ? (int64_t)(int16_t)value : (int64_t)value;
+        for (uint8_t width = 0; width <= 8; width++) {
+            uint8_t len = Format_Number16(buffer, value, width, flags);
+            Test_Compare("Format_Number16", expected, width, flags, buffer, len);
+        }
+    }
+}
+
+static void Test_Number32(uint32_t value) {
+    char buffer[FORMAT_MAX_LEN + 8];
+
+    for (uint8_t flags = 0; flags < 8; flags++) {
+        int64_t expected = (flags & FORMAT_SIGNED) ? (int64_t)(int32_t)value : (int64_t)value;
+        for (uint8_t width = 0; width <= FORMAT_MAX_LEN; width++) {
+            uint8_t len = Format_Number32(buffer, value, width, flags);
+            Test_Compare("Format_Number32", expected, width, flags, buffer, len);
+        }
+    }
+}
+
+// --- The int_to_string Format.c replaced ---
+static void Old_reverse(char s[]) {
+    uint8_t i, j;
+    char c;
+    for (i = 0, j = strlen(s) - 1; i < j; i++, j--) {
+        c = s[i];
+        s[i] = s[j];
+        s[j] = c;
+    }
+}
+
+// Never call it with a negative value: nothing is converted, and reverse()
+// of the empty string starts at strlen() - 1 = 255 and writes past the end
+static void Old_int_to_string(int32_t value, char *buffer) {
+    uint8_t i = 0;
+
+    if (value == 0) {
+        buffer[i++] = '0';
+        buffer[i] = '\0';
+        return;
+    }
+    while (value > 0) {
+        buffer[i++] = (value % 10) + '0';
+        value /= 10;
+    }
+    buffer[i] = '\0';
+    Old_reverse(buffer);
+}
+
+// What __udivmodsi4 does on the AVR: one quotient bit per step
+static uint32_t Old_Divmod(uint32_t value, uint32_t divisor, uint32_t* remainder) {
+    uint32_t rest = 0;
+
+    for (uint8_t bit = 0; bit < 32; bit++) {
+        rest = (rest << 1) | (value >> 31);
+        value <<= 1;
+        if (rest >= divisor) {
+            rest -= divisor;
+            value |= 1;
+        }
+    }
+    *remainder = rest;
+    return value;
+}
+
+// Old_int_to_string with the AVR's divide in place of % and /
+static void Old_int_to_string_avr_div(int32_t value, char *buffer) {
+    uint8_t i = 0;
+    uint32_t digit;
+
+    if (value == 0) {
+        buffer[i++] = '0';
+        buffer[i] = '\0';
+        return;
+    }
+    while (value > 0) {
+        value = (int32_t)Old_Divmod((uint32_t)value, 10, &digit);
+        buffer[i++] = digit + '0';
+    }
+    buffer[i] = '\0';
+    Old_reverse(buffer);
+}
+
+// __divmodsi4 calls per call of Old_int_to_string on the AVR: one per digit
+static uint8_t Old_Divisions(int32_t value) {
+    uint8_t count = 0;
+    while (value > 0) {
+        value /= 10;
+        count++;
+    }
+    return count;
+}
+
+static char Bench_Buffer[FORMAT_MAX_LEN + 8];
+
+static void Bench_Old(int32_t value) {
+    Old_int_to_string(value, Bench_Buffer);
+}
+
+static void Bench_Old_Avr_Div(int32_t value) {
+    Old_int_to_string_avr_div(value, Bench_Buffer);
+}
+
+static void Bench_New(int32_t value) {
+    Format_Number32(Bench_Buffer, (uint32_t)value, 0, FORMAT_SIGNED);
+}
+
+static void Bench_None(int32_t value) {
+    (void)value;
+}
+
+// Instructions from one stop of the child to the next, or -1 without ptrace
+static long Bench_Instructions(void (*volatile call)(int32_t), int32_t value) {
+    int status;
+    long steps = 0;
+    pid_t child = fork();
+
+    if (child == 0) {
+        ptrace(PTRACE_TRACEME, 0, NULL, NULL);
+        raise(SIGSTOP);
+        call(value);
+        raise(SIGSTOP);
+        _exit(0);
+    }
+    if (child < 0 || waitpid(child, &status, 0) < 0 || !WIFSTOPPED(status)) {
+        return -1;
+    }
+    for (;;) {
+        if (ptrace(PTRACE_SINGLESTEP, child, NULL, NULL) < 0 || waitpid(child, &status, 0) < 0) {
+            steps = -1;
+            break;
+        }
+        if (!WIFSTOPPED(status) || WSTOPSIG(status) == SIGSTOP) {
+            break;
+        }
+        steps++;
+    }
+    kill(child, SIGKILL);
+    waitpid(child, &status, 0);
+    return steps;
+}
+
+static double Bench_ns(void (*volatile call)(int32_t), int32_t value) {
+    const uint32_t calls = 1000000;
+    struct timespec start, end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t i = 0; i < calls; i++) {
+        call(value);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / calls;
+}
+
+static void Bench_Compare(void) {
+    static const int32_t values[] = { 0, 7, 42, 100, 1023, 65535, 1000000, INT32_MAX, -1, INT32_MIN };
+    long overhead = Bench_Instructions(Bench_None, 0);
+
+    printf("\nint_to_string before (%% 10, / 10, reverse) and after (Format_Number32, FORMAT_SIGNED)\n");
+    printf("%12s | %7s %7s %7s %7s | %7s %7s\n", "value", "divides", "old ins", "avr div", "old ns", "new ins", "new ns");
+    for (uint8_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        int32_t value = values[i];
+        long new_ins = Bench_Instructions(Bench_New, value);
+        double new_ns = Bench_ns(Bench_New, value);
+
+        if (value < 0) {
+            // The old version has no sign handling (see Old_int_to_string)
+            printf("%12" PRId32 " | %31s | %7ld %7.1f\n", value, "no negative values",
+                   (overhead < 0 || new_ins < 0) ? -1 : new_ins - overhead, new_ns);
+            continue;
+        }
+        long old_ins = Bench_Instructions(Bench_Old, value);
+        long avr_ins = Bench_Instructions(Bench_Old_Avr_Div, value);
+        if (overhead < 0 || old_ins < 0 || avr_ins < 0 || new_ins < 0) {
+            // No ptrace here: wall time only
+            old_ins = avr_ins = new_ins = overhead - 1;
+        }
+        printf("%12" PRId32 " | %7u %7ld %7ld %7.1f | %7ld %7.1f\n", value, Old_Divisions(value),
+               old_ins - overhead, avr_ins - overhead, Bench_ns(Bench_Old, value), new_ins - overhead, new_ns);
+    }
+    printf("divides = __divmodsi4 calls on the AVR, ins = x86-64 instructions per call (ptrace\n"
+           "single-step, -1 = not available), avr div = old ins with the AVR's shift-subtract\n"
+           "divide, ns = host wall time per call\n");
+}
+
+int main(void) {
+    uint32_t seed = 12345;
+
+    for (uint16_t value = 0; value < 256; value++) {
+        Test_Number8((uint8_t)value);
+    }
+    for (uint32_t value = 0; value < 65536; value++) {
+        Test_Number16((uint16_t)value);
+    }
+
+    // Every power of ten, its neighbours and their negatives, then the extremes
+    for (uint32_t pow10 = 1; ; pow10 *= 10) {
+        Test_Number32(pow10 - 1);
+        Test_Number32(pow10);
+        Test_Number32(pow10 + 1);
+        Test_Number32(0 - (pow10 - 1));
+        Test_Number32(0 - pow10);
+        Test_Number32(0 - (pow10 + 1));
+        if (pow10 == 1000000000UL) {
+            break;
+        }
+    }
+    Test_Number32((uint32_t)INT32_MIN);
+    Test_Number32((uint32_t)INT32_MIN + 1);
+    Test_Number32((uint32_t)INT32_MAX);
+    Test_Number32(UINT32_MAX);
+    for (uint32_t i = 0; i < 20000; i++) {
+        seed = seed * 1103515245UL + 12345UL;
+        // Also short values: the length in digits is spread evenly
+        Test_Number32(seed >> (seed % 32));
+    }
+
+    printf("Test_Format: %lu checks, %lu failures\n", Test_Checks, Test_Failures);
+    if (Test_Failures == 0) {
+        Bench_Compare();
+    }
+    return Test_Failures != 0;
+}
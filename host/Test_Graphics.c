@@ -0,0 +1,237 @@
+/*
+ * File:   Test_Graphics.c
+ * Author: Mostafa Eshra
+ *
+ * Description: Host test of Graphics.c against per-pixel references, on a
+ *              framebuffer that stands in for GLCD_ReadByte/GLCD_WriteByte.
+ *              TEST_CASES random calls of every primitive on a random
+ *              screen: all three colors, positions and sizes past the
+ *              edges (clipping), odd bitmap heights at every y. Each call
+ *              is compared pixel by pixel with the same call drawn by the
+ *              reference, which works out every pixel on its own:
+ *              rectangles and bitmaps by definition, lines as the point
+ *              nearest the ideal line at each step of the longer axis
+ *              (Bresenham, exact ties go towards the end point).
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "GLCD.h"
+#include "Graphics.h"
+
+#define TEST_CASES   50000UL
+
+static unsigned long Test_Checks = 0;
+static unsigned long Test_Failures = 0;
+
+// --- Framebuffer ---
+static uint8_t Test_FB[GLCD_PAGES][GLCD_WIDTH];
+
+uint8_t GLCD_ReadByte(uint8_t page, uint8_t column) {
+    return Test_FB[page][column];
+}
+
+void GLCD_WriteByte(uint8_t page, uint8_t column, uint8_t data) {
+    Test_FB[page][column] = data;
+}
+
+// --- Reference ---
+// One byte per pixel; Test_Mark collects the pixels of a call first, so
+// GFX_INVERT flips each of them once however often the shape names it
+static uint8_t Test_Screen[GLCD_HEIGHT][GLCD_WIDTH];
+static uint8_t Test_Mark[GLCD_HEIGHT][GLCD_WIDTH];
+
+static void Ref_Mark(int x, int y) {
+    if (x >= 0 && x < GLCD_WIDTH && y >= 0 && y < GLCD_HEIGHT) {
+        Test_Mark[y][x] = 1;
+    }
+}
+
+static void Ref_Apply(uint8_t color) {
+    for (int y = 0; y < GLCD_HEIGHT; y++) {
+        for (int x = 0; x < GLCD_WIDTH; x++) {
+            if (!Test_Mark[y][x]) {
+                continue;
+            }
+            if (color == GFX_SET) {
+                Test_Screen[y][x] = 1;
+            } else if (color == GFX_CLEAR) {
+                Test_Screen[y][x] = 0;
+            } else {
+                Test_Screen[y][x] ^= 1;
+            }
+        }
+    }
+    memset(Test_Mark, 0, sizeof(Test_Mark));
+}
+
+static void Ref_Fill_Rect(int x, int y, int width, int height) {
+    for (int j = 0; j < height; j++) {
+        for (int i = 0; i < width; i++) {
+            Ref_Mark(x + i, y + j);
+        }
+    }
+}
+
+static void Ref_Rect(int x, int y, int width, int height) {
+    if (width == 0 || height == 0) {
+        return;
+    }
+    for (int i = 0; i < width; i++) {
+        Ref_Mark(x + i, y);
+        Ref_Mark(x + i, y + height - 1);
+    }
+    for (int j = 0; j < height; j++) {
+        Ref_Mark(x, y + j);
+        Ref_Mark(x + width - 1, y + j);
+    }
+}
+
+// Step i of n along the longer axis moves the other one by round(i * d / n)
+static void Ref_Line(int x0, int y0, int x1, int y1) {
+    int dx = (x1 > x0) ? x1 - x0 : x0 - x1;
+    int dy = (y1 > y0) ? y1 - y0 : y0 - y1;
+    int sx = (x1 > x0) ? 1 : -1;
+    int sy = (y1 > y0) ? 1 : -1;
+    int n = (dx > dy) ? dx : dy;
+
+    if (n == 0) {
+        Ref_Mark(x0, y0);
+        return;
+    }
+    for (int i = 0; i <= n; i++) {
+        if (dx >= dy) {
+            Ref_Mark(x0 + sx * i, y0 + sy * ((2 * i * dy + dx) / (2 * dx)));
+        } else {
+            Ref_Mark(x0 + sx * ((2 * i * dx + dy) / (2 * dy)), y0 + sy * i);
+        }
+    }
+}
+
+static void Ref_Bitmap(int x, int y, const uint8_t* bitmap, int width, int height) {
+    for (int j = 0; j < height; j++) {
+        for (int i = 0; i < width; i++) {
+            if (bitmap[(j >> 3) * width + i] & (1 << (j & 7))) {
+                Ref_Mark(x + i, y + j);
+            }
+        }
+    }
+}
+
+// --- Cases ---
+static uint32_t Test_Seed = 12345;
+
+static uint32_t Test_Random(uint32_t range) {
+    Test_Seed = Test_Seed * 1103515245UL + 12345UL;
+    return (Test_Seed >> 8) % range;
+}
+
+// Random screen, in both representations
+static void Test_Fill_Screen(void) {
+    for (int page = 0; page < GLCD_PAGES; page++) {
+        for (int x = 0; x < GLCD_WIDTH; x++) {
+            uint8_t data = (uint8_t)Test_Random(256);
+            Test_FB[page][x] = data;
+            for (int bit = 0; bit < 8; bit++) {
+                Test_Screen[page * 8 + bit][x] = (data >> bit) & 1;
+            }
+        }
+    }
+}
+
+static void Test_Compare(unsigned long index, const char* what, int a, int b, int c, int d, uint8_t color) {
+    unsigned wrong = 0;
+
+    for (int y = 0; y < GLCD_HEIGHT; y++) {
+        for (int x = 0; x < GLCD_WIDTH; x++) {
+            if (((Test_FB[y >> 3][x] >> (y & 7)) & 1) != Test_Screen[y][x]) {
+                wrong++;
+            }
+        }
+    }
+    Test_Checks++;
+    if (wrong != 0 && Test_Failures++ < 20) {
+        printf("case %lu: %s(%d, %d, %d, %d, color %u): %u pixels differ\n", index, what, a, b, c, d, color, wrong);
+    }
+}
+
+static void Test_Case(unsigned long index) {
+    static uint8_t bitmap[4 * 40];
+    uint8_t color = (uint8_t)Test_Random(3);
+    // Up to a bit past the edges
+    int x = (int)Test_Random(GLCD_WIDTH + 16);
+    int y = (int)Test_Random(GLCD_HEIGHT + 16);
+    int width = (int)Test_Random(GLCD_WIDTH + 8);
+    int height = (int)Test_Random(GLCD_HEIGHT + 8);
+
+    Test_Fill_Screen();
+    switch (Test_Random(7)) {
+        case 0:
+            Gfx_Pixel(x, y, color);
+            Ref_Mark(x, y);
+            Ref_Apply(color);
+            Test_Compare(index, "Gfx_Pixel", x, y, 0, 0, color);
+            break;
+        case 1:
+            Gfx_HLine(x, y, width, color);
+            Ref_Fill_Rect(x, y, width, 1);
+            Ref_Apply(color);
+            Test_Compare(index, "Gfx_HLine", x, y, width, 1, color);
+            break;
+        case 2:
+            Gfx_VLine(x, y, height, color);
+            Ref_Fill_Rect(x, y, 1, height);
+            Ref_Apply(color);
+            Test_Compare(index, "Gfx_VLine", x, y, 1, height, color);
+            break;
+        case 3:
+            Gfx_Fill_Rect(x, y, width, height, color);
+            Ref_Fill_Rect(x, y, width, height);
+            Ref_Apply(color);
+            Test_Compare(index, "Gfx_Fill_Rect", x, y, width, height, color);
+            break;
+        case 4:
+            Gfx_Rect(x, y, width, height, color);
+            Ref_Rect(x, y, width, height);
+            Ref_Apply(color);
+            Test_Compare(index, "Gfx_Rect", x, y, width, height, color);
+            break;
+        case 5: {
+            // Half of them axis-aligned, the fast paths
+            int x1 = (int)Test_Random(GLCD_WIDTH + 16);
+            int y1 = (int)Test_Random(GLCD_HEIGHT + 16);
+            switch (Test_Random(4)) {
+                case 0: y1 = y; break;
+                case 1: x1 = x; break;
+                default: break;
+            }
+            Gfx_Line(x, y, x1, y1, color);
+            Ref_Line(x, y, x1, y1);
+            Ref_Apply(color);
+            Test_Compare(index, "Gfx_Line", x, y, x1, y1, color);
+            break;
+        }
+        default: {
+            // Every height 1-32 (partial last rows), up to 40 columns
+            width = 1 + (int)Test_Random(40);
+            height = 1 + (int)Test_Random(32);
+            for (int i = 0; i < ((height + 7) >> 3) * width; i++) {
+                bitmap[i] = (uint8_t)Test_Random(256);
+            }
+            Gfx_Bitmap(x, y, bitmap, width, height, color);
+            Ref_Bitmap(x, y, bitmap, width, height);
+            Ref_Apply(color);
+            Test_Compare(index, "Gfx_Bitmap", x, y, width, height, color);
+            break;
+        }
+    }
+}
+
+int main(void) {
+    for (unsigned long i = 0; i < TEST_CASES; i++) {
+        Test_Case(i);
+    }
+
+    printf("Test_Graphics: %lu checks, %lu failures\n", Test_Checks, Test_Failures);
+    return Test_Failures != 0;
+}
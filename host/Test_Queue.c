@@ -0,0 +1,185 @@
+/*
+ * File:   Test_Queue.c
+ * Author: Mostafa Eshra
+ *
+ * Description: Host test of the GLCD output path on the KS0108 model
+ *              (firmware built as for DISPLAY_VIEW 0). Every write keeps
+ *              its chip busy for a random time, from a couple of cycles to
+ *              longer than a queue tick, so the Timer2 ISR keeps stopping
+ *              at a busy chip. Interrupts are on after GLCD_Init, as in
+ *              main(). Each frame draws at random (framebuffer bytes,
+ *              Graphics.c, text, GLCD_FillPages, GLCD_DataBurst, start
+ *              lines) and is flushed the way the display tasks do it: a
+ *              GLCD_Flush that stops at a full queue is called again a
+ *              random time later, sometimes after more drawing. Half of
+ *              the frames are followed straight by the next one; the
+ *              others wait for GLCD_Frame_Complete, and then every panel
+ *              RAM byte and both start lines must equal the framebuffer.
+ *              No write may reach a busy chip.
+ *              Built once with the queue and once with GLCD_QUEUE=0 (the
+ *              direct bus, where no flush stops part way).
+ */
+
+#include <stdio.h>
+#include <avr/interrupt.h>
+#include "Host.h"
+#include "KS0108.h"
+#include "GLCD.h"
+#include "Graphics.h"
+
+#define TEST_FRAMES           600
+#define TEST_MAX_DRAWS        6
+// Scheduler tick (Timer0 overflow at /64) and the model time allowed
+#define TEST_TICK_CYCLES      (64UL * 256)
+#define TEST_BUDGET_MS        60000UL
+
+static unsigned long Test_Checks = 0;
+static unsigned long Test_Failures = 0;
+static unsigned long Test_Resumed = 0;      // GLCD_Flush calls that stopped part way
+static unsigned long Test_Compared = 0;     // Frames checked against the panel
+static uint32_t Test_Seed = 4242;
+
+static uint32_t Test_Random(uint32_t range) {
+    Test_Seed = Test_Seed * 1103515245UL + 12345UL;
+    return (Test_Seed >> 8) % range;
+}
+
+// Mostly 1-3 us, one write in eight 6-125 us (past a queue tick)
+static uint32_t Test_Busy(void) {
+    if (Test_Random(8) == 0) {
+        return 100 + Test_Random(1900);
+    }
+    return 16 + Test_Random(33);
+}
+
+// --- Drawing ---
+static const char* const Test_Strings[4] = { "PWM Duty:", "42%", "Scope", "0123456789" };
+
+// small = one framebuffer byte, as a task updating a value
+static void Test_Draw(uint8_t count, uint8_t small) {
+    while (count--) {
+        uint8_t x = (uint8_t)Test_Random(GLCD_WIDTH);
+        uint8_t y = (uint8_t)Test_Random(GLCD_HEIGHT);
+        uint8_t color = (uint8_t)Test_Random(3);
+
+        switch (small ? 15 : Test_Random(16)) {
+            case 0:
+                GLCD_FillPages((uint8_t)Test_Random(GLCD_PAGES), (uint8_t)Test_Random(GLCD_PAGES),
+                               (uint8_t)Test_Random(256));
+                break;
+            case 1:
+                GLCD_SetStartLine((uint8_t)(1 + Test_Random(3)), (uint8_t)Test_Random(GLCD_HEIGHT));
+                break;
+            case 2:
+            case 3: {
+                uint8_t buf[GLCD_WIDTH];
+                uint8_t len = (uint8_t)(1 + Test_Random(GLCD_WIDTH));
+                for (uint8_t i = 0; i < len; i++) {
+                    buf[i] = (uint8_t)Test_Random(256);
+                }
+                GLCD_DataBurst(y >> 3, x, buf, len);
+                break;
+            }
+            case 4:
+            case 5:
+                GLCD_WriteString(y >> 3, x, Test_Strings[Test_Random(4)]);
+                break;
+            case 6:
+            case 7:
+            case 8:
+                Gfx_Fill_Rect(x, y, (uint8_t)Test_Random(GLCD_WIDTH), (uint8_t)Test_Random(GLCD_HEIGHT), color);
+                break;
+            case 9:
+            case 10:
+            case 11:
+                Gfx_Line(x, y, (uint8_t)Test_Random(GLCD_WIDTH), (uint8_t)Test_Random(GLCD_HEIGHT), color);
+                break;
+            default:
+                for (uint8_t i = small ? 7 : 0; i < 8; i++) {
+                    GLCD_WriteByte((uint8_t)Test_Random(GLCD_PAGES), (uint8_t)Test_Random(GLCD_WIDTH),
+                                   (uint8_t)Test_Random(256));
+                }
+                break;
+        }
+    }
+}
+
+// --- Checks ---
+static void Test_Expect(const char* what, unsigned long frame, unsigned long got, unsigned long expected) {
+    Test_Checks++;
+    if (got != expected && Test_Failures++ < 20) {
+        printf("frame %lu: %s = 0x%02lX, expected 0x%02lX\n", frame, what, got, expected);
+    }
+}
+
+// The panel must show exactly the framebuffer
+static void Test_Compare(unsigned long frame) {
+    char what[32];
+
+    // Lets the last store of the firmware reach the model
+    Host_Idle(0);
+    for (uint8_t page = 0; page < GLCD_PAGES; page++) {
+        for (uint8_t x = 0; x < GLCD_WIDTH; x++) {
+            snprintf(what, sizeof(what), "page %u column %u", page, x);
+            Test_Expect(what, frame, KS0108_RAM(x, page), GLCD_ReadByte(page, x));
+        }
+    }
+    Test_Expect("chip 1 start line", frame, KS0108_Start_Line(GLCD_CHIP_1), GLCD_GetStartLine(GLCD_CHIP_1));
+    Test_Expect("chip 2 start line", frame, KS0108_Start_Line(GLCD_CHIP_2), GLCD_GetStartLine(GLCD_CHIP_2));
+    Test_Compared++;
+}
+
+// --- Running ---
+static void Test_Start(void) {
+    GLCD_Init();
+    Test_Compare(0);
+    sei();
+}
+
+static void Test_Frames(void) {
+    for (unsigned long frame = 1; frame <= TEST_FRAMES; frame++) {
+        Test_Draw((uint8_t)(1 + Test_Random(TEST_MAX_DRAWS)), 0);
+
+        // As Display_Task: what did not fit is retried on a later tick
+        while (!GLCD_Flush()) {
+            Test_Resumed++;
+            Host_Idle(1 + Test_Random(2 * TEST_TICK_CYCLES));
+            if (Test_Random(4) == 0) {
+                Test_Draw(1, 1);
+            }
+        }
+
+        if (Test_Random(2) == 0) {
+            continue;   // The next frame queues up behind this one
+        }
+        while (!GLCD_Frame_Complete()) {
+            Host_Idle(16);
+        }
+        Test_Compare(frame);
+    }
+}
+
+int main(void) {
+    const uint64_t budget = TEST_BUDGET_MS * (F_CPU / 1000UL);
+    KS0108_Stats stats;
+
+    Host_Reset();
+    KS0108_Init();
+    KS0108_Set_Busy_Source(Test_Busy);
+    if (Host_Run(Test_Start, budget) || Host_Run(Test_Frames, budget)) {
+        printf("Test_Queue: did not finish within %lu ms of model time\n", TEST_BUDGET_MS);
+        return 1;
+    }
+
+    KS0108_Get_Stats(&stats);
+    Test_Checks++;
+    if (stats.violations != 0) {
+        printf("%lu writes to a busy chip\n", (unsigned long)stats.violations);
+        Test_Failures++;
+    }
+
+    printf("Test_Queue (GLCD_QUEUE=%d): %u frames, %lu compared with the panel, %lu resumed flushes, "
+           "%lu checks, %lu failures\n", GLCD_QUEUE, TEST_FRAMES, Test_Compared, Test_Resumed,
+           Test_Checks, Test_Failures);
+    return Test_Failures != 0;
+}
@@ -0,0 +1,209 @@
+/*
+ * File:   Test_Waveform.c
+ * Author: Mostafa Eshra
+ *
+ * Description: Host test of Waveform.c on a framebuffer that stands in for
+ *              GLCD_WriteByte. TEST_CASES random geometries (page spans,
+ *              columns, period counts, amplitudes, grid on/off) each get a
+ *              random screen and a random sequence of duties, repeats and
+ *              out-of-range values included. After every Waveform_Draw,
+ *              incremental or after Waveform_Invalidate, the whole screen
+ *              must equal a reference that works out every pixel of a
+ *              fresh draw on its own, and nothing outside the periods may
+ *              have been touched.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "GLCD.h"
+#include "Waveform.h"
+
+#define TEST_CASES   20000UL
+#define TEST_DRAWS   12
+
+static unsigned long Test_Checks = 0;
+static unsigned long Test_Failures = 0;
+static uint32_t Test_Seed = 777;
+
+static uint32_t Test_Random(uint32_t range) {
+    Test_Seed = Test_Seed * 1103515245UL + 12345UL;
+    return (Test_Seed >> 8) % range;
+}
+
+// --- Framebuffer ---
+static uint8_t Test_FB[GLCD_PAGES][GLCD_WIDTH];
+
+void GLCD_WriteByte(uint8_t page, uint8_t column, uint8_t data) {
+    Test_FB[page][column] = data;
+}
+
+// --- Reference ---
+typedef struct {
+    int first_page;
+    int pages;
+    int column;
+    int period;
+    int periods;
+    int grid;
+    int top;                // Rows relative to the top of the span
+    int bottom;
+    int middle;
+} Ref_Geometry;
+
+// Waveform_Init's clipping and level rows, worked out separately
+static void Ref_Init(Ref_Geometry* g, int first_page, int last_page, int column, int width,
+                     int periods, int amplitude, int grid) {
+    if (last_page > GLCD_PAGES - 1) {
+        last_page = GLCD_PAGES - 1;
+    }
+    if (first_page > last_page) {
+        first_page = last_page;
+    }
+    if (column + width > GLCD_WIDTH) {
+        width = GLCD_WIDTH - column;
+    }
+    if (periods == 0) {
+        periods = 1;
+    }
+    g->first_page = first_page;
+    g->pages = last_page - first_page + 1;
+    g->column = column;
+    g->periods = periods;
+    g->period = width / periods;
+    g->grid = grid;
+
+    int rows = g->pages * 8;
+    if (amplitude < 2 || amplitude > rows) {
+        amplitude = rows;
+    }
+    g->top = (rows - amplitude) / 2;
+    g->bottom = g->top + amplitude - 1;
+    g->middle = (g->top + g->bottom) / 2;
+}
+
+// Pixel of row r (from the top of the span) in column c of period k
+static int Ref_Pixel(const Ref_Geometry* g, int high, int k, int c, int r) {
+    int offset = k * g->period + c;
+    int on;
+
+    if (high == 0) {
+        on = (r == g->bottom);
+    } else if (high >= g->period) {
+        on = (r == g->top);
+    } else if (c == high || (c == g->period - 1 && k != g->periods - 1)) {
+        on = (r >= g->top && r <= g->bottom);       // Falling or rising edge
+    } else {
+        on = (r == ((c < high) ? g->top : g->bottom));
+    }
+    if (g->grid && offset % WAVEFORM_GRID_STEP == 0 && r >= g->top && r <= g->bottom && (r & 1) == 0) {
+        on = 1;
+    }
+    if (g->grid && offset % WAVEFORM_GRID_DOT == 0 && r == g->middle) {
+        on = 1;
+    }
+    return on;
+}
+
+// The screen a fresh draw of high leaves on top of background
+static void Ref_Draw(const Ref_Geometry* g, int high, const uint8_t background[GLCD_PAGES][GLCD_WIDTH],
+                     uint8_t screen[GLCD_PAGES][GLCD_WIDTH]) {
+    memcpy(screen, background, GLCD_PAGES * GLCD_WIDTH);
+    if (g->period == 0) {
+        return;
+    }
+    if (high > g->period) {
+        high = g->period;
+    }
+    for (int k = 0; k < g->periods; k++) {
+        for (int c = 0; c < g->period; c++) {
+            int x = g->column + k * g->period + c;
+            for (int p = 0; p < g->pages; p++) {
+                uint8_t data = 0;
+                for (int bit = 0; bit < 8; bit++) {
+                    data |= (uint8_t)(Ref_Pixel(g, high, k, c, p * 8 + bit) << bit);
+                }
+                screen[g->first_page + p][x] = data;
+            }
+        }
+    }
+}
+
+// --- Checks ---
+static void Test_Compare(const char* what, const Ref_Geometry* g, int high,
+                         const uint8_t expected[GLCD_PAGES][GLCD_WIDTH]) {
+    Test_Checks++;
+    for (int page = 0; page < GLCD_PAGES; page++) {
+        for (int x = 0; x < GLCD_WIDTH; x++) {
+            if (Test_FB[page][x] == expected[page][x]) {
+                continue;
+            }
+            if (Test_Failures++ < 20) {
+                printf("%s: pages %d+%d column %d period %d x%d rows %d-%d grid %d, high %d: "
+                       "page %d column %d = 0x%02X, expected 0x%02X\n",
+                       what, g->first_page, g->pages, g->column, g->period, g->periods, g->top,
+                       g->bottom, g->grid, high, page, x, Test_FB[page][x], expected[page][x]);
+            }
+            return;
+        }
+    }
+}
+
+int main(void) {
+    static uint8_t background[GLCD_PAGES][GLCD_WIDTH];
+    static uint8_t expected[GLCD_PAGES][GLCD_WIDTH];
+
+    for (unsigned long i = 0; i < TEST_CASES; i++) {
+        Waveform wf;
+        Ref_Geometry g;
+        uint8_t first_page = (uint8_t)Test_Random(GLCD_PAGES + 1);
+        uint8_t last_page = (uint8_t)(first_page + Test_Random(4));
+        uint8_t column = (uint8_t)Test_Random(GLCD_WIDTH);
+        uint8_t width = (uint8_t)Test_Random(GLCD_WIDTH + 8);
+        uint8_t periods = (uint8_t)Test_Random(6);
+        uint8_t amplitude = (uint8_t)Test_Random(40);
+        uint8_t grid = (uint8_t)Test_Random(2);
+
+        for (int page = 0; page < GLCD_PAGES; page++) {
+            for (int x = 0; x < GLCD_WIDTH; x++) {
+                background[page][x] = (uint8_t)Test_Random(256);
+            }
+        }
+        memcpy(Test_FB, background, sizeof(Test_FB));
+
+        Waveform_Init(&wf, first_page, last_page, column, width, periods, amplitude, grid);
+        Ref_Init(&g, first_page, last_page, column, width, periods, amplitude, grid);
+        Test_Checks++;
+        if (Waveform_Period_Width(&wf) != g.period && Test_Failures++ < 20) {
+            printf("period width %u, expected %d\n", Waveform_Period_Width(&wf), g.period);
+        }
+
+        for (int d = 0; d < TEST_DRAWS; d++) {
+            // Mostly inside the period, sometimes the ends, past it or a repeat
+            int high;
+            switch (Test_Random(8)) {
+                case 0:  high = 0; break;
+                case 1:  high = g.period; break;
+                case 2:  high = g.period + 1 + (int)Test_Random(4); break;
+                case 3:  high = (d == 0) ? 0 : wf.high; break;
+                default: high = (g.period > 0) ? (int)Test_Random((uint32_t)g.period) : 0; break;
+            }
+            if (high > 255) {
+                high = 255;
+            }
+
+            if (Test_Random(8) == 0) {
+                Waveform_Invalidate(&wf);
+                Waveform_Draw(&wf, (uint8_t)high);
+                Ref_Draw(&g, high, background, expected);
+                Test_Compare("after invalidate", &g, high, expected);
+            } else {
+                Waveform_Draw(&wf, (uint8_t)high);
+                Ref_Draw(&g, high, background, expected);
+                Test_Compare("incremental", &g, high, expected);
+            }
+        }
+    }
+
+    printf("Test_Waveform: %lu checks, %lu failures\n", Test_Checks, Test_Failures);
+    return Test_Failures != 0;
+}
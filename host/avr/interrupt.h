@@ -0,0 +1,23 @@
+/*
+ * File:   interrupt.h (host)
+ * Author: Mostafa Eshra
+ *
+ * Description: Host stand-in for <avr/interrupt.h>. An ISR is a plain
+ *              function named after its vector; host/Host.c calls it when
+ *              the flag and enable bits are set and SREG's I bit is on.
+ */
+
+#ifndef HOST_AVR_INTERRUPT_H
+#define	HOST_AVR_INTERRUPT_H
+
+#include <avr/io.h>
+
+#define ISR(vector, ...)   void vector(void); void vector(void)
+
+// One-cycle instructions on the target: one register access here
+void Host_Sei(void);
+void Host_Cli(void);
+#define sei()              Host_Sei()
+#define cli()              Host_Cli()
+
+#endif	/* HOST_AVR_INTERRUPT_H */
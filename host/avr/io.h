@@ -0,0 +1,192 @@
+/*
+ * File:   io.h (host)
+ * Author: Mostafa Eshra
+ *
+ * Description: Host stand-in for <avr/io.h>, ATmega32 only. The I/O
+ *              registers are bytes of Host_IO[] at their real I/O addresses
+ *              (so DIO.c's PORTx - 1 / PORTx - 2 arithmetic still works), and
+ *              the firmware is compiled with every memory access instrumented:
+ *              host/Host.c sees each register read and write, counts it and
+ *              runs the timers, the ADC and the interrupts on a model clock.
+ */
+
+#ifndef HOST_AVR_IO_H
+#define	HOST_AVR_IO_H
+
+#include <stdint.h>
+
+// Size unknown here on purpose: accesses with a constant index into a global
+// of known size would not be instrumented
+extern uint8_t Host_IO[];
+
+#define _SFR_IO8(addr)     (*(volatile uint8_t*)&Host_IO[(addr)])
+#define _SFR_IO16(addr)    (*(volatile uint16_t*)&Host_IO[(addr)])
+#define _SFR_IO_ADDR(reg)  ((uint8_t)((volatile uint8_t*)&(reg) - (volatile uint8_t*)Host_IO))
+#define _BV(bit)           (1 << (bit))
+
+// --- Registers (I/O addresses) ---
+#define SREG    _SFR_IO8(0x3F)
+#define OCR0    _SFR_IO8(0x3C)
+#define GICR    _SFR_IO8(0x3B)
+#define GIFR    _SFR_IO8(0x3A)
+#define TIMSK   _SFR_IO8(0x39)
+#define TIFR    _SFR_IO8(0x38)
+#define MCUCR   _SFR_IO8(0x35)
+#define TCCR0   _SFR_IO8(0x33)
+#define TCNT0   _SFR_IO8(0x32)
+#define SFIOR   _SFR_IO8(0x30)
+#define TCCR1A  _SFR_IO8(0x2F)
+#define TCCR1B  _SFR_IO8(0x2E)
+#define TCNT1   _SFR_IO16(0x2C)
+#define TCNT1L  _SFR_IO8(0x2C)
+#define TCNT1H  _SFR_IO8(0x2D)
+#define OCR1A   _SFR_IO16(0x2A)
+#define OCR1AL  _SFR_IO8(0x2A)
+#define OCR1AH  _SFR_IO8(0x2B)
+#define OCR1B   _SFR_IO16(0x28)
+#define OCR1BL  _SFR_IO8(0x28)
+#define OCR1BH  _SFR_IO8(0x29)
+#define ICR1    _SFR_IO16(0x26)
+#define ICR1L   _SFR_IO8(0x26)
+#define ICR1H   _SFR_IO8(0x27)
+#define TCCR2   _SFR_IO8(0x25)
+#define TCNT2   _SFR_IO8(0x24)
+#define OCR2    _SFR_IO8(0x23)
+#define ASSR    _SFR_IO8(0x22)
+#define PORTA   _SFR_IO8(0x1B)
+#define DDRA    _SFR_IO8(0x1A)
+#define PINA    _SFR_IO8(0x19)
+#define PORTB   _SFR_IO8(0x18)
+#define DDRB    _SFR_IO8(0x17)
+#define PINB    _SFR_IO8(0x16)
+#define PORTC   _SFR_IO8(0x15)
+#define DDRC    _SFR_IO8(0x14)
+#define PINC    _SFR_IO8(0x13)
+#define PORTD   _SFR_IO8(0x12)
+#define DDRD    _SFR_IO8(0x11)
+#define PIND    _SFR_IO8(0x10)
+#define ADMUX   _SFR_IO8(0x07)
+#define ADCSRA  _SFR_IO8(0x06)
+#define ADCH    _SFR_IO8(0x05)
+#define ADCL    _SFR_IO8(0x04)
+#define ADCW    _SFR_IO16(0x04)
+#define ADC     _SFR_IO16(0x04)
+
+// --- Bits ---
+#define SREG_I  7
+
+// TIMSK / TIFR
+#define OCIE2   7
+#define TOIE2   6
+#define TICIE1  5
+#define OCIE1A  4
+#define OCIE1B  3
+#define TOIE1   2
+#define OCIE0   1
+#define TOIE0   0
+#define OCF2    7
+#define TOV2    6
+#define ICF1    5
+#define OCF1A   4
+#define OCF1B   3
+#define TOV1    2
+#define OCF0    1
+#define TOV0    0
+
+// TCCR0 / TCCR2
+#define FOC0    7
+#define WGM00   6
+#define COM01   5
+#define COM00   4
+#define WGM01   3
+#define CS02    2
+#define CS01    1
+#define CS00    0
+#define FOC2    7
+#define WGM20   6
+#define COM21   5
+#define COM20   4
+#define WGM21   3
+#define CS22    2
+#define CS21    1
+#define CS20    0
+
+// TCCR1A / TCCR1B
+#define COM1A1  7
+#define COM1A0  6
+#define COM1B1  5
+#define COM1B0  4
+#define FOC1A   3
+#define FOC1B   2
+#define WGM11   1
+#define WGM10   0
+#define ICNC1   7
+#define ICES1   6
+#define WGM13   4
+#define WGM12   3
+#define CS12    2
+#define CS11    1
+#define CS10    0
+
+// SFIOR
+#define ADTS2   7
+#define ADTS1   6
+#define ADTS0   5
+#define ACME    3
+#define PUD     2
+#define PSR2    1
+#define PSR10   0
+
+// ADMUX / ADCSRA
+#define REFS1   7
+#define REFS0   6
+#define ADLAR   5
+#define MUX4    4
+#define MUX3    3
+#define MUX2    2
+#define MUX1    1
+#define MUX0    0
+#define ADEN    7
+#define ADSC    6
+#define ADATE   5
+#define ADIF    4
+#define ADIE    3
+#define ADPS2   2
+#define ADPS1   1
+#define ADPS0   0
+
+// Port pins
+#define PA0 0
+#define PA1 1
+#define PA2 2
+#define PA3 3
+#define PA4 4
+#define PA5 5
+#define PA6 6
+#define PA7 7
+#define PB0 0
+#define PB1 1
+#define PB2 2
+#define PB3 3
+#define PB4 4
+#define PB5 5
+#define PB6 6
+#define PB7 7
+#define PC0 0
+#define PC1 1
+#define PC2 2
+#define PC3 3
+#define PC4 4
+#define PC5 5
+#define PC6 6
+#define PC7 7
+#define PD0 0
+#define PD1 1
+#define PD2 2
+#define PD3 3
+#define PD4 4
+#define PD5 5
+#define PD6 6
+#define PD7 7
+
+#endif	/* HOST_AVR_IO_H */
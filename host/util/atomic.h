@@ -0,0 +1,40 @@
+/*
+ * File:   atomic.h (host)
+ * Author: Mostafa Eshra
+ *
+ * Description: Host stand-in for <util/atomic.h>, built like avr-libc's:
+ *              SREG is saved and I cleared on entry, and a cleanup handler
+ *              restores it however the block is left. Both go through the
+ *              instrumented SREG, so the model sees the interrupts off.
+ */
+
+#ifndef HOST_UTIL_ATOMIC_H
+#define	HOST_UTIL_ATOMIC_H
+
+#include <stdint.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+static __inline__ uint8_t Host_Atomic_Enter(void) {
+    cli();
+    return 1;
+}
+
+static __inline__ void Host_Atomic_Restore(const uint8_t* sreg) {
+    SREG = *sreg;
+}
+
+static __inline__ void Host_Atomic_Force_On(const uint8_t* sreg) {
+    (void)sreg;
+    sei();
+}
+
+#define ATOMIC_RESTORESTATE \
+    uint8_t sreg_save __attribute__((__cleanup__(Host_Atomic_Restore))) = SREG
+#define ATOMIC_FORCEON \
+    uint8_t sreg_save __attribute__((__cleanup__(Host_Atomic_Force_On))) = 0
+
+#define ATOMIC_BLOCK(type) \
+    for (type, host_todo = Host_Atomic_Enter(); host_todo; host_todo = 0)
+
+#endif	/* HOST_UTIL_ATOMIC_H */
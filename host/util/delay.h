@@ -0,0 +1,18 @@
+/*
+ * File:   delay.h (host)
+ * Author: Mostafa Eshra
+ *
+ * Description: Host stand-in for <util/delay.h>. The requested time is
+ *              counted and passes on the model clock (timers keep running
+ *              and interrupts are taken meanwhile, as on the target).
+ */
+
+#ifndef HOST_UTIL_DELAY_H
+#define	HOST_UTIL_DELAY_H
+
+void Host_Delay_us(double us);
+
+#define _delay_us(us)      Host_Delay_us(us)
+#define _delay_ms(ms)      Host_Delay_us((ms) * 1000.0)
+
+#endif	/* HOST_UTIL_DELAY_H */
@@ -3,9 +3,9 @@
  */
 
 #include <avr/io.h>
+#include <avr/interrupt.h>
 #include <util/delay.h> // Added for GLCD delay functions
 #include <stdint.h> // Added for uint8_t, int32_t types
-#include <math.h>
 #include <string.h>
 
 // --- Include Dependencies ---
@@ -13,74 +13,514 @@
 #include "DIO.h"
 #include "Timer.h"
 #include "GLCD.h" // New GLCD Header
+#include "Scheduler.h"
+#include "Duty.h"
+#include "Filter.h"
+#include "Capture.h"
+#include "Widget.h"
+#include "Font.h"
+#include "Format.h"
+#include "StripChart.h"
+#include "Scope.h"
+#include "View.h"
 
 #define High 0x01
 #define Low 0x80
 
+// --- Task Timing (in Timer0 ticks of 1.024 ms) ---
+#define CONTROL_TASK_PERIOD    1
+#define CONTROL_TASK_DEADLINE  1
+#define DISPLAY_TASK_PERIOD    SCHEDULER_MS_TO_TICKS(100)
+#define DISPLAY_TASK_DEADLINE  SCHEDULER_MS_TO_TICKS(100)
+
+#define CHART_TASK_PERIOD      SCHEDULER_MS_TO_TICKS(20)
+#define CHART_TASK_DEADLINE    SCHEDULER_MS_TO_TICKS(20)
+#define SCOPE_TASK_PERIOD      SCHEDULER_MS_TO_TICKS(200)
+#define SCOPE_TASK_DEADLINE    SCHEDULER_MS_TO_TICKS(200)
+
+// --- Scope Capture Settings ---
+// 16 MHz / 16 = 1 MHz ADC clock -> ~77 kSa/s (8-bit accuracy)
+#define SCOPE_CHANNEL          ADC_CH7
+#define SCOPE_PRESCALER        ADC_PRE_16
+#define SCOPE_TRIGGER_LEVEL    128
+#define SCOPE_TRIGGER_EDGE     SCOPE_EDGE_RISING
+
+// The screen to build (DISPLAY_VIEW) is picked in View.h
+
+// Set to 1 to show worst-case run time / missed deadlines on page 7
+#define SHOW_TASK_STATS        1
+
+// --- ADC Scan Sequencer ---
+// Set to 0 to sample ADC_CH6 only. PA0-PA5 carry the GLCD control lines, so
+// ADC6 (PA6) and ADC7 (PA7) are the only inputs free on this board.
+#define ADC_SCAN               1
+
+// What starts each conversion (ADC_TRIG_*). Timer0 overflow = BOTTOM of the
+// PB3 PWM period: the sample is taken a fixed 1.5-2.5 ADC clocks after the
+// rising edge, every 1.024 ms (~976 Sa/s shared by the scanned channels).
+#define ADC_TRIGGER            ADC_TRIG_TIMER0_OVF
+
+// PWM outputs a scanned channel can drive
+#define PWM_OUT_OC0            0    // PB3, 8-bit (dithered with TIMER0_DITHER)
+#define PWM_OUT_OC1A           1    // PD5, 10-bit
+#define PWM_OUT_OC1B           2    // PD4, 10-bit
+// PD7, 8-bit. Only without GLCD_QUEUE: the queue runs its tick on Timer2,
+// so a scan entry using OC2 does not build while it is on.
+#if !GLCD_QUEUE
+#define PWM_OUT_OC2            3
+#endif
+
+#if ADC_SCAN
+typedef struct {
+    uint8_t channel;
+    uint8_t output;
+} Scan_Map_t;
+
+// Entry 0 is also the displayed channel
+static const Scan_Map_t scan_map[] = {
+    { ADC_CH6, PWM_OUT_OC0 },
+    { ADC_CH7, PWM_OUT_OC1B },
+};
+#define SCAN_COUNT  (sizeof(scan_map) / sizeof(scan_map[0]))
+#endif
+
+// OC1A (PD5) carries the full 10-bit duty: Timer1 runs at 16 MHz with the
+// fixed TOP = 1023 (15.625 kHz), so the ADC reading is the compare value
+// as-is and ICR1 stays free for the input capture below
+
+// --- PWM Output Measurement ---
+// Loop PB3 (OC0) back into ICP1 (PD6): Capture.h measures the real period
+// and high time, shown next to the commanded duty (waveform view)
+#define SHOW_CAPTURE           1
+
+// Latest ADC reading (10-bit, filtered), shared by the control and display tasks
+static uint16_t adc_val = 0;
+
+static uint8_t control_task_id;
+#if DISPLAY_VIEW != DISPLAY_VIEW_SCOPE
+static uint8_t display_task_id;
+#endif
+#if DISPLAY_VIEW == DISPLAY_VIEW_STRIP_CHART
+static uint8_t chart_task_id;
+#endif
+#if DISPLAY_VIEW == DISPLAY_VIEW_SCOPE
+static uint8_t scope_task_id;
+#endif
+
+#if DISPLAY_VIEW == DISPLAY_VIEW_WAVEFORM
+// Retained widgets, redrawn only when their value changes
+static uint8_t duty_number_id;
+static uint8_t duty_bar_id;
+static uint8_t duty_trace_id;
+#endif
+
+// --- PWM Outputs ---
+#if ADC_SCAN
+static void PWM_Output_Init(uint8_t output) {
+    switch (output) {
+        case PWM_OUT_OC1B:
+            Timer1_COMP_MODE(TIMER1_CH_B, TIMER1_COMP_MODE_PWM_NON_INVERTING);
+            break;
+#ifdef PWM_OUT_OC2
+        case PWM_OUT_OC2:
+            // Same 976 Hz as OC0
+            init_Timer2(TIMER2_MODE_FPWM, TIMER2_CS_PRE_64);
+            Timer2_COMP_MODE(TIMER2_COMP_MODE_PWM_SET_ON_COUNT_UP);
+            break;
+#endif
+        default:
+            // OC0 and OC1A are always set up in main()
+            break;
+    }
+}
+#endif
+
+// Sets one output from a filtered ADC reading (FILTER_BITS wide)
+static void PWM_Output_Write(uint8_t output, uint16_t value) {
+    switch (output) {
+        case PWM_OUT_OC0:
+#if TIMER0_DITHER
+            // Every filtered bit as 8.8 duty, the overflow ISR dithers OCR0 between steps
+            Timer0_SET_DUTY16(value << (16 - FILTER_BITS));
+#else
+            // Scale 10-bit value (0-1023) to 8-bit value (0-255) for OCR0
+            Timer0_SET_COMP_VAL(Duty_To_OCR(FILTER_TO_10BIT(value)));
+#endif
+            break;
+        case PWM_OUT_OC1A:
+            // Full 10-bit value (TOP = 1023)
+            Timer1_SET_COMP_VAL(TIMER1_CH_A, FILTER_TO_10BIT(value));
+            break;
+        case PWM_OUT_OC1B:
+            Timer1_SET_COMP_VAL(TIMER1_CH_B, FILTER_TO_10BIT(value));
+            break;
+#ifdef PWM_OUT_OC2
+        case PWM_OUT_OC2:
+            Timer2_SET_COMP_VAL(Duty_To_OCR(FILTER_TO_10BIT(value)));
+            break;
+#endif
+    }
+}
+
+// --- ADC to PWM Control Task ---
+#if ADC_SCAN
+static uint16_t scan_sweeps = 0;
+
+static void Control_Task(void) {
+    uint16_t results[SCAN_COUNT];
+    uint16_t sweeps;
+    uint8_t i;
+
+    // Nothing to do until the sequencer has published a new sweep
+    sweeps = ADC_Scan_Get_Sweeps();
+    if (sweeps == scan_sweeps) {
+        return;
+    }
+    scan_sweeps = sweeps;
+
+    ADC_Scan_Read(results);
+    adc_val = FILTER_TO_10BIT(results[0]);
+    for (i = 0; i < SCAN_COUNT; i++) {
+        PWM_Output_Write(scan_map[i].output, results[i]);
+    }
+
+    // OC1A mirrors the displayed channel with the full 10 bits
+    PWM_Output_Write(PWM_OUT_OC1A, results[0]);
+}
+#else
+static void Control_Task(void) {
+    uint16_t samples[ADC_BUFFER_SIZE];
+    uint8_t sample_count;
+
+    // Drain everything converted since the last pass, keep the newest
+    sample_count = ADC_Buffer_Read(samples, ADC_BUFFER_SIZE);
+    if (sample_count == 0) {
+        return;
+    }
+    adc_val = FILTER_TO_10BIT(samples[sample_count - 1]);
+
+    PWM_Output_Write(PWM_OUT_OC0, samples[sample_count - 1]);
+    PWM_Output_Write(PWM_OUT_OC1A, samples[sample_count - 1]);
+}
+#endif
+
+#if SHOW_TASK_STATS && DISPLAY_VIEW != DISPLAY_VIEW_SCOPE
+// Writes "<label><wcet us>/<missed>" for one task at the given column of page 7
+// (fixed width, 10 characters, so no blanking is needed between updates)
+static void Show_Task_Stats(uint8_t column, char label, uint8_t task_id) {
+    char buffer[FORMAT_MAX_LEN * 2];
+    uint8_t len = 0;
+
+    buffer[len++] = label;
+    len += Format_Number32(&buffer[len], (uint32_t)Scheduler_Get_WCET(task_id) * SCHEDULER_COUNT_US, 5, 0);
+    buffer[len++] = '/';
+    Format_Number16(&buffer[len], Scheduler_Get_Missed(task_id), 3, 0);
+
+    GLCD_WriteString(7, column, buffer);
+}
+#endif
+
+#if SHOW_TASK_STATS && GLCD_STATS && DISPLAY_VIEW == DISPLAY_VIEW_WAVEFORM
+// Writes "<bus bytes>/<bus time us>" for the previous frame at the given column of page 7
+static void Show_Frame_Stats(uint8_t column) {
+    GLCD_Stats frame;
+    char buffer[FORMAT_MAX_LEN * 2];
+    uint8_t len = 0;
+
+    GLCD_Get_Frame_Stats(&frame);
+
+    len += Format_Number32(&buffer[len], frame.data_bytes + frame.commands, 4, 0);
+    buffer[len++] = '/';
+    Format_Number32(&buffer[len], GLCD_Stats_Bus_Time_us(&frame), 5, 0);
+
+    GLCD_WriteString(7, column, buffer);
+}
+#endif
+
+#if SHOW_TASK_STATS && ADC_TRIGGER_STATS && DISPLAY_VIEW == DISPLAY_VIEW_WAVEFORM
+// Writes "ADC<rate>Hz j<jitter>us" on page 2 (fixed width)
+static void Show_ADC_Stats(void) {
+    ADC_Trigger_Stats stats;
+    char buffer[FORMAT_MAX_LEN * 2];
+    uint8_t len = 0;
+
+    ADC_Get_Trigger_Stats(&stats);
+    ADC_Reset_Trigger_Stats();
+
+    buffer[len++] = 'A';
+    buffer[len++] = 'D';
+    buffer[len++] = 'C';
+    len += Format_Number32(&buffer[len], stats.rate_hz, 5, 0);
+    buffer[len++] = 'H';
+    buffer[len++] = 'z';
+    buffer[len++] = ' ';
+    buffer[len++] = 'j';
+    len += Format_Number16(&buffer[len], stats.jitter_us, 4, 0);
+    buffer[len++] = 'u';
+    buffer[len++] = 's';
+    buffer[len] = '\0';
+
+    GLCD_WriteString(2, 2, buffer);
+}
+#endif
+
+#if SHOW_CAPTURE && DISPLAY_VIEW == DISPLAY_VIEW_WAVEFORM
+// Writes permille as "ddd.d%" (6 characters) and returns the length
+static uint8_t Format_Permille(char* buffer, uint16_t permille) {
+    uint8_t len = Format_Number16(buffer, permille, 4, 0);
+
+    // Move the last digit behind a decimal point: " 501" -> " 50.1"
+    buffer[len] = buffer[len - 1];
+    buffer[len - 1] = '.';
+    if (buffer[len - 2] == ' ') {
+        buffer[len - 2] = '0';
+    }
+    len++;
+    buffer[len++] = '%';
+    buffer[len] = '\0';
+    return len;
+}
+
+// Commanded OC0 duty on page 3, duty and frequency measured on ICP1 on page 4
+static void Show_Capture(void) {
+    Capture_Result measured;
+    char buffer[FORMAT_MAX_LEN * 2];
+    uint8_t len;
+
+    // Average OC0 duty in fast PWM is (OCR0 + 1) / 256, OCR0 = adc / 4
+    // (fractional when dithered, whole steps otherwise)
+#if TIMER0_DITHER
+    uint16_t commanded = (uint16_t)((((uint32_t)adc_val + 4) * 1000UL + 512) >> 10);
+#else
+    uint16_t commanded = (uint16_t)((((uint32_t)Duty_To_OCR(adc_val) + 1) * 1000UL + 128) >> 8);
+#endif
+    if (commanded > 1000) {
+        commanded = 1000;       // OCR0 = 255 is already constant high
+    }
+
+    len = 0;
+    buffer[len++] = 'S';
+    buffer[len++] = 'e';
+    buffer[len++] = 't';
+    Format_Permille(&buffer[len], commanded);
+    GLCD_WriteString(3, 2, buffer);
+
+    Capture_Get(&measured);
+    len = 0;
+    buffer[len++] = 'A';
+    buffer[len++] = 'c';
+    buffer[len++] = 't';
+    len += Format_Permille(&buffer[len], measured.duty_permille);
+    buffer[len++] = ' ';
+    Format_Number32(&buffer[len], measured.freq_hz, 5, 0);
+    GLCD_WriteString(4, 2, buffer);
+    GLCD_WriteString(4, 100, "Hz");
+}
+#endif
+
+#if DISPLAY_VIEW != DISPLAY_VIEW_SCOPE
+// Draws the readouts into the framebuffer
+static void Display_Draw(void) {
+#if DISPLAY_VIEW == DISPLAY_VIEW_STRIP_CHART
+    char buffer[5]; // Buffer for displaying 0-100 value (3 digits + '%' + '\0')
+
+    //calculate the PWM percentage (fixed point, see Duty.h), right-aligned
+    Format_Number8(buffer, Duty_To_Percent(adc_val), 3, FORMAT_PERCENT);
+    GLCD_WriteString(2, 2, buffer);
+#else
+    // Percent, bar and one PWM period per half; unchanged widgets are skipped
+    Widget_Set_Value(duty_number_id, Duty_To_Percent(adc_val));
+    Widget_Set_Value(duty_bar_id, adc_val);
+    Widget_Set_Value(duty_trace_id, adc_val);
+    Widget_Render();
+#endif
+
+#if SHOW_TASK_STATS && ADC_TRIGGER_STATS && DISPLAY_VIEW == DISPLAY_VIEW_WAVEFORM
+    Show_ADC_Stats();
+#endif
+#if SHOW_CAPTURE && DISPLAY_VIEW == DISPLAY_VIEW_WAVEFORM
+    Show_Capture();
+#endif
+
+#if SHOW_TASK_STATS && DISPLAY_VIEW == DISPLAY_VIEW_STRIP_CHART
+    // The right half belongs to the chart (it scrolls)
+    Show_Task_Stats(0, 'C', control_task_id);
+#elif SHOW_TASK_STATS && GLCD_STATS
+    Show_Task_Stats(0, 'C', control_task_id);
+    Show_Frame_Stats(GLCD_WIDTH / 2);
+#elif SHOW_TASK_STATS
+    Show_Task_Stats(0, 'C', control_task_id);
+    Show_Task_Stats(GLCD_WIDTH / 2, 'D', display_task_id);
+#endif
+}
+
+// --- GLCD Update Task ---
+// Only draws into the framebuffer and flushes the changes, never waits. A
+// frame that does not fit the GLCD queue is finished on the next ticks
+// (Scheduler_Retry) without drawing again in between.
+static void Display_Task(void) {
+    static uint8_t flushing = 0;
+
+    if (!flushing) {
+        Display_Draw();
+    }
+    flushing = !GLCD_Flush();
+    if (flushing) {
+        Scheduler_Retry();
+    }
+}
+#endif
+
+#if DISPLAY_VIEW == DISPLAY_VIEW_STRIP_CHART
+// --- Strip Chart Task ---
+// One new row per run, the rest of the trace is moved by the start line
+static void Chart_Task(void) {
+    static uint8_t flushing = 0;
+
+    if (!flushing) {
+        StripChart_Push(Duty_To_Width(adc_val, STRIPCHART_WIDTH - 1));
+    }
+    flushing = !GLCD_Flush();
+    if (flushing) {
+        Scheduler_Retry();
+    }
+}
+#endif
+
+#if DISPLAY_VIEW == DISPLAY_VIEW_SCOPE
+// --- Scope Task ---
+// Starts a capture and checks it on the following ticks (Scheduler_Retry),
+// the ADC ISR fills it meanwhile; then draws it and the rate
+static void Scope_Task(void) {
+    static uint8_t flushing = 0;
+    static uint8_t capturing = 0;
+    char buffer[FORMAT_MAX_LEN + 8];
+    uint8_t len;
+
+    if (flushing) {
+        // The rest of the last frame, no new capture in this release
+        flushing = !GLCD_Flush();
+        if (flushing) {
+            Scheduler_Retry();
+        }
+        return;
+    }
+    if (!capturing) {
+        if (!GLCD_Frame_Complete()) {
+            // Let the last frame finish, so the GLCD queue ISR does not
+            // delay the ADC ISR during the burst
+            Scheduler_Retry();
+            return;
+        }
+        Scope_Capture_Start(SCOPE_CHANNEL, SCOPE_PRESCALER,
+                            SCOPE_TRIGGER_LEVEL, SCOPE_TRIGGER_EDGE);
+        capturing = 1;
+    }
+    uint8_t result = Scope_Capture_Poll();
+    if (result == SCOPE_BUSY) {
+        // Waiting for the trigger (up to SCOPE_TRIGGER_TIMEOUT samples, ~27 ms)
+        // or the burst itself (~1.7 ms): the other tasks keep running
+        Scheduler_Retry();
+        return;
+    }
+    capturing = 0;
+    Scope_Render(1, 7, SCOPE_TIME_1X, SCOPE_GAIN_1X, 1);
+
+    // "<rate>kSa/s" plus T (triggered) or A (auto) on page 0
+    len = Format_Number16(buffer, (uint16_t)(Scope_Get_Sample_Rate() / 1000), 3, 0);
+    buffer[len++] = 'k';
+    buffer[len++] = 'S';
+    buffer[len++] = 'a';
+    buffer[len++] = '/';
+    buffer[len++] = 's';
+    buffer[len++] = ' ';
+    buffer[len++] = (result == SCOPE_TRIGGERED) ? 'T' : 'A';
+    buffer[len] = '\0';
+    GLCD_WriteString(0, 50, buffer);
+
+    flushing = !GLCD_Flush();
+    if (flushing) {
+        Scheduler_Retry();
+    }
+}
+#endif
+
 int main(void)
 {
     // --- System & Peripheral Setup ---
     // 1. Configure ADC input pin (PA6) as INPUT
     DIO_Set_PIN_DIR(&PORTA, PA6, INPUT); 
     
-    // 2. Initialize ADC on Channel 6 (PA6)
-    // Assuming ADC functions are available (e.g., init_ADC)
-     init_ADC(ADC_CH6, ADC_REF_AREF, ADC_PRE_32); 
+    // 2. Initialize ADC on Channel 6 (PA6), interrupt driven, one conversion
+    // per ADC_TRIGGER event (16 MHz / 128 = 125 kHz ADC clock, 104 us each)
+     init_ADC(ADC_CH6, ADC_REF_AREF, ADC_PRE_128); 
+     ADC_select_TRIGGER(ADC_TRIGGER);
+#if ADC_SCAN
+    {
+        uint8_t channels[SCAN_COUNT];
+        uint8_t i;
+
+        for (i = 0; i < SCAN_COUNT; i++) {
+            channels[i] = scan_map[i].channel;
+            DIO_Set_PIN_DIR(&PORTA, scan_map[i].channel, INPUT);
+        }
+        ADC_Start_Scan(channels, SCAN_COUNT);
+    }
+#else
+     ADC_Start_FreeRunning();
+#endif
     
     // 3. Initialize Timer0 for Fast PWM mode (Output on PB3)
+    // Its overflow (every 1.024 ms) is also the scheduler tick
     init_Timer0(TIMER0_MODE_FPWM, TIMER0_CS_PRE_64);
     Timer0_COMP_MODE(TIMER0_COMP_MODE_PWM_SET_ON_COUNT_UP);
+
+    // Timer1 Fast PWM with fixed 10-bit TOP, duty on OC1A (PD5)
+    init_Timer1(TIMER1_MODE_FPWM_10BIT, TIMER1_CS_NO_PRE);
+    Timer1_COMP_MODE(TIMER1_CH_A, TIMER1_COMP_MODE_PWM_NON_INVERTING);
+#if SHOW_CAPTURE && DISPLAY_VIEW == DISPLAY_VIEW_WAVEFORM
+    Capture_Init();
+#endif
+#if ADC_SCAN
+    for (uint8_t i = 0; i < SCAN_COUNT; i++) {
+        PWM_Output_Init(scan_map[i].output);
+    }
+#endif
     
     // 4. Initialize GLCD (Control on PORTA, Data on PORTC)
-    GLCD_Init();
-    GLCD_ClearScreen();
+    GLCD_Init();    // Also clears the screen
     
-    int adc_val = 0;
-    float PWM_Per = 0;
-    uint8_t duty_cycle_val;
-    char buffer[5]; // Buffer for displaying 0-100 value (max 3 digits + '%' + '\0')
+#if DISPLAY_VIEW == DISPLAY_VIEW_STRIP_CHART
+    GLCD_WriteString(0, 2, "PWM Duty:");
+    StripChart_Init();
+#elif DISPLAY_VIEW == DISPLAY_VIEW_SCOPE
+    GLCD_WriteString(0, 2, "Scope");
+#else
+    // Waveform screen: static label (page 0), duty bar (page 1), the percent
+    // in 16-row digits to their right (pages 0-1, "100%" is 44 columns),
+    // one PWM period per chip half (pages 5-6)
+    Widget_Add_Label(0, 2, "PWM Duty:");
+    duty_number_id = Widget_Add_Font_Number(0, GLCD_WIDTH - 46, 46, &Font_Digits_16, FORMAT_PERCENT);
+    duty_bar_id = Widget_Add_Bar(1, 2, GLCD_WIDTH - 52, DUTY_ADC_MAX);
+    duty_trace_id = Widget_Add_Trace(5, 0, GLCD_WIDTH, 2, DUTY_ADC_MAX);
+#endif
     
-    // Display a static label once
-    // Using GLCD_GoToPageColumn to explicitly set the cursor before writing the label
-    GLCD_GoToPageColumn(0, 2); // Page 0, Column 2
-    GLCD_WriteString(0, 2, "PWM Duty Cycle:");
+    // 5. Register tasks, control first so it has the higher priority
+    Scheduler_Init();
+    control_task_id = Scheduler_Add_Task(Control_Task, CONTROL_TASK_PERIOD, CONTROL_TASK_DEADLINE);
+#if DISPLAY_VIEW == DISPLAY_VIEW_SCOPE
+    scope_task_id = Scheduler_Add_Task(Scope_Task, SCOPE_TASK_PERIOD, SCOPE_TASK_DEADLINE);
+#else
+    display_task_id = Scheduler_Add_Task(Display_Task, DISPLAY_TASK_PERIOD, DISPLAY_TASK_DEADLINE);
+#endif
+#if DISPLAY_VIEW == DISPLAY_VIEW_STRIP_CHART
+    chart_task_id = Scheduler_Add_Task(Chart_Task, CHART_TASK_PERIOD, CHART_TASK_DEADLINE);
+#endif
+    
+    sei();
     
     while (1) {
-        // --- ADC to PWM Control Loop ---
-        
-        // Ensure the ADC is still reading Channel 6
-         ADC_select_CH(ADC_CH6);
-        
-        // Start ADC conversion and read 10-bit value
-         ADC_SC();
-         adc_val = ADC_read();
-
-        // Scale 10-bit value (0-1023) to 8-bit value (0-255) for OCR0
-        duty_cycle_val = (uint8_t)(adc_val/4);
-        Timer0_SET_COMP_VAL(duty_cycle_val);
-        
-        // --- GLCD Update Logic ---
-        //calculate the PWM percentage
-        PWM_Per = (adc_val/1023.0) * 100;
-        
-        int_to_string((uint8_t)(PWM_Per), buffer);
-
-        
-        // Add the '%' symbol to the end of the string
-        uint8_t len = 0;
-        while (buffer[len] != '\0') {
-            len++;
-        }
-        buffer[len] = '%';
-        buffer[len + 1] = '\0';
-        
-        GLCD_Write_Per(buffer);
-        
-        //3. Draw the signal
-        char Signal_High = round((PWM_Per/100) * 64); 
-                
-        GLCD_Draw_Signal(Signal_High);
-        
+        Scheduler_Run();
    }
     return 0;
 }